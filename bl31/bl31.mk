@@ -64,6 +64,22 @@ BL31_SOURCES		+=	lib/pmf/pmf_main.c				\
 				${VENDOR_EL3_SRCS}
 endif
 
+ifeq (${PSCI_BULK_CPU_ON}, 1)
+BL31_SOURCES		+=	${VENDOR_EL3_SRCS}
+endif
+
+ifeq (${SPMC_DIRECT_MSG_BATCH}, 1)
+BL31_SOURCES		+=	${VENDOR_EL3_SRCS}
+endif
+
+ifeq (${ENABLE_DEFERRED_LOG}, 1)
+BL31_SOURCES		+=	common/tf_log_deferred.c
+endif
+
+ifeq (${ENABLE_SMC_LATENCY_HIST}, 1)
+BL31_SOURCES		+=	lib/pmf/pmf_smc_hist.c
+endif
+
 include lib/debugfs/debugfs.mk
 ifeq (${USE_DEBUGFS},1)
 BL31_SOURCES		+=	${DEBUGFS_SRCS}					\
@@ -17,6 +17,7 @@
 #include <common/debug.h>
 #include <common/feat_detect.h>
 #include <common/runtime_svc.h>
+#include <common/tf_log_deferred.h>
 #include <drivers/arm/dsu.h>
 #include <drivers/arm/gic.h>
 #include <drivers/console.h>
@@ -236,6 +237,7 @@ void __no_pauth bl31_main(u_register_t arg0, u_register_t arg1, u_register_t arg
 
 	console_flush();
 	console_switch_state(CONSOLE_FLAG_RUNTIME);
+	tf_log_deferred_start();
 }
 
 void __no_pauth bl31_warmboot(void)
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2016-2025, Arm Limited and Contributors. All rights reserved.
+# Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -27,6 +27,10 @@ BL32_SOURCES		+=	services/el3/ven_el3_svc.c			\
 				lib/pmf/pmf_main.c
 endif
 
+ifeq (${ENABLE_SMC_LATENCY_HIST}, 1)
+BL32_SOURCES		+=	lib/pmf/pmf_smc_hist.c
+endif
+
 ifneq (${ENABLE_FEAT_AMU},0)
 BL32_SOURCES		+=	${AMU_SOURCES}
 endif
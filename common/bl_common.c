@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <arch.h>
@@ -15,7 +16,9 @@
 #include <common/bl_common.h>
 #include <common/build_message.h>
 #include <common/debug.h>
+#include <common/image_decompress.h>
 #include <drivers/auth/auth_mod.h>
+#include <drivers/io/io_driver.h>
 #include <drivers/io/io_storage.h>
 #include <lib/utils.h>
 #include <lib/xlat_tables/xlat_tables_defs.h>
@@ -49,6 +52,122 @@ static int dyn_is_auth_disabled(void)
 }
 #endif /* TRUSTED_BOARD_BOOT */
 
+#if IMAGE_HASH_STREAMING
+/*
+ * Size of the chunks in which an image is read when it is hashed while being
+ * loaded. Each chunk is hashed right after it has been read, while it is still
+ * present in the data cache.
+ */
+#ifndef PLAT_IMAGE_HASH_STREAM_CHUNK_SIZE
+#define PLAT_IMAGE_HASH_STREAM_CHUNK_SIZE	U(0x8000)
+#endif
+
+/*******************************************************************************
+ * Read an image in chunks and pass each of them to the authentication module,
+ * so that the image hash is ready as soon as the last chunk has been read.
+ ******************************************************************************/
+static int read_image_hash_stream(uintptr_t image_handle, uintptr_t image_base,
+				  size_t image_size, size_t *bytes_read)
+{
+	size_t chunk_size, chunk_read;
+	int io_result;
+
+	*bytes_read = 0U;
+
+	while (*bytes_read < image_size) {
+		chunk_size = MIN(image_size - *bytes_read,
+				 (size_t)PLAT_IMAGE_HASH_STREAM_CHUNK_SIZE);
+		chunk_read = 0U;
+
+		io_result = io_read(image_handle, image_base + *bytes_read,
+				    chunk_size, &chunk_read);
+		if (io_result != 0) {
+			return io_result;
+		}
+
+		auth_mod_hash_stream_update((void *)(image_base + *bytes_read),
+					    (unsigned int)chunk_read);
+		*bytes_read += chunk_read;
+
+		/* Let the caller deal with the short read */
+		if (chunk_read < chunk_size) {
+			break;
+		}
+	}
+
+	return 0;
+}
+#endif /* IMAGE_HASH_STREAMING */
+
+#if IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2)
+/*******************************************************************************
+ * Read a compressed image in chunks and decompress each of them to the final
+ * location of the image, so that the compressed data is never held in full.
+ * If 'hash_stream' is set, the compressed data is hashed on the way and the
+ * hash is then bound to the decompressed image that is authenticated.
+ ******************************************************************************/
+static int read_image_decompress_stream(uintptr_t image_handle,
+					image_info_t *image_data,
+					size_t image_size, bool hash_stream)
+{
+	uintptr_t chunk_base;
+	size_t chunk_max, chunk_size, chunk_read;
+	size_t bytes_read = 0U;
+	int io_result;
+
+	io_result = image_decompress_stream_start(image_data, &chunk_base,
+						  &chunk_max);
+	if (io_result != 0) {
+		return io_result;
+	}
+
+	while (bytes_read < image_size) {
+		chunk_size = MIN(image_size - bytes_read, chunk_max);
+		chunk_read = 0U;
+
+		io_result = io_read(image_handle, chunk_base, chunk_size,
+				    &chunk_read);
+		if (io_result != 0) {
+			return io_result;
+		}
+
+		if (chunk_read < chunk_size) {
+			WARN("Image read too short (%zu of %zu Bytes)\n",
+			     bytes_read + chunk_read, image_size);
+			return -EIO;
+		}
+
+#if IMAGE_HASH_STREAMING
+		if (hash_stream) {
+			auth_mod_hash_stream_consume((void *)chunk_base,
+						     (unsigned int)chunk_read);
+		}
+#endif
+
+		io_result = image_decompress_stream_update(chunk_read);
+		if (io_result != 0) {
+			return io_result;
+		}
+
+		bytes_read += chunk_read;
+	}
+
+	io_result = image_decompress_stream_finish(image_data);
+	if (io_result != 0) {
+		return io_result;
+	}
+
+#if IMAGE_HASH_STREAMING
+	if (hash_stream) {
+		auth_mod_hash_stream_bind((void *)image_data->image_base,
+					  image_data->image_size);
+	}
+#endif
+
+	return 0;
+}
+#endif /* IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2) */
+
 uintptr_t page_align(uintptr_t value, unsigned dir)
 {
 	/* Round up the limit to the next page boundary */
@@ -66,11 +185,19 @@ uintptr_t page_align(uintptr_t value, unsigned dir)
  * Internal function to load an image at a specific address given
  * an image ID and extents of free memory.
  *
- * If the load is successful then the image information is updated.
+ * If the load is successful then the image information is updated. If
+ * 'hash_stream' is set, the image is passed to the authentication module while
+ * it is read (see auth_mod_hash_stream_start()). If the image has the
+ * IMAGE_ATTRIB_ZERO_COPY attribute and sits on memory-mapped storage, it is not
+ * copied and its address on the storage is returned in image_data->image_base.
+ * The attribute is cleared if the image had to be copied instead. If the image
+ * has the IMAGE_ATTRIB_DECOMPRESS_STREAM attribute, it is decompressed while it
+ * is read and image_data->image_size is updated to the decompressed size.
  *
  * Returns 0 on success, a negative error code otherwise.
  ******************************************************************************/
-static int load_image(unsigned int image_id, image_info_t *image_data)
+static int load_image(unsigned int image_id, image_info_t *image_data,
+		      bool hash_stream)
 {
 	uintptr_t dev_handle = 0ULL;
 	uintptr_t image_handle = 0ULL;
@@ -130,8 +257,75 @@ static int load_image(unsigned int image_id, image_info_t *image_data)
 	 */
 	image_data->image_size = (uint32_t)image_size;
 
+#if IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2)
+	if ((image_data->h.attr & IMAGE_ATTRIB_DECOMPRESS_STREAM) != 0U) {
+		io_result = read_image_decompress_stream(image_handle,
+							 image_data,
+							 image_size,
+							 hash_stream);
+		if (io_result != 0) {
+			WARN("Failed to load image id=%u (%i)\n", image_id,
+			     io_result);
+			/*
+			 * Do not leave behind data decompressed from a payload
+			 * that may have failed to decrypt or authenticate.
+			 */
+			zero_normalmem((void *)image_base,
+				       image_data->image_max_size);
+			flush_dcache_range(image_base,
+					   image_data->image_max_size);
+			goto exit_load_image;
+		}
+
+		INFO("Image id=%u decompressed: 0x%lx - 0x%lx\n", image_id,
+		     image_base,
+		     (uintptr_t)(image_base + image_data->image_size));
+		goto exit_load_image;
+	}
+#endif /* IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2) */
+
+#if ZERO_COPY_IMAGE_LOAD
+	/*
+	 * If the image is accessed in place, try to get its address on the
+	 * storage rather than copying it. Fall back on a regular load if the
+	 * storage is not memory-mapped.
+	 */
+	if ((image_data->h.attr & IMAGE_ATTRIB_ZERO_COPY) != 0U) {
+		io_result = io_map(image_handle, image_size, &image_base);
+		if (io_result == 0) {
+			image_data->image_base = image_base;
+			INFO("Image id=%u mapped: 0x%lx - 0x%lx\n", image_id,
+			     image_base, (uintptr_t)(image_base + image_size));
+#if IMAGE_HASH_STREAMING
+			if (hash_stream) {
+				auth_mod_hash_stream_update((void *)image_base,
+							    (unsigned int)image_size);
+			}
+#endif
+			goto exit_load_image;
+		}
+
+		if (io_result != -ENODEV) {
+			WARN("Failed to map image id=%u (%i)\n", image_id,
+			     io_result);
+			goto exit_load_image;
+		}
+
+		image_data->h.attr &= ~IMAGE_ATTRIB_ZERO_COPY;
+	}
+#endif /* ZERO_COPY_IMAGE_LOAD */
+
 	/* We have enough space so load the image now */
-	io_result = io_read(image_handle, image_base, image_size, &bytes_read);
+#if IMAGE_HASH_STREAMING
+	if (hash_stream) {
+		io_result = read_image_hash_stream(image_handle, image_base,
+						   image_size, &bytes_read);
+	} else
+#endif
+	{
+		io_result = io_read(image_handle, image_base, image_size,
+				    &bytes_read);
+	}
 	if (io_result != 0) {
 		WARN("Failed to load image id=%u (%i)\n", image_id, io_result);
 		goto exit_load_image;
@@ -181,19 +375,54 @@ static int load_auth_image_recursive(unsigned int image_id,
 {
 	int rc;
 	unsigned int parent_id;
+	bool hash_stream = false;
+#if ZERO_COPY_IMAGE_LOAD || (IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2))
+	uintptr_t image_base = image_data->image_base;
+	uint32_t image_attr = image_data->h.attr;
+#endif
 
 	/* Use recursion to authenticate parent images */
 	rc = auth_mod_get_parent_id(image_id, &parent_id);
 	if (rc == 0) {
+#if IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2)
+		/* Only the image itself is compressed, not its certificates */
+		image_data->h.attr &= ~IMAGE_ATTRIB_DECOMPRESS_STREAM;
+#endif
 		rc = load_auth_image_recursive(parent_id, image_data);
 		if (rc != 0) {
 			return rc;
 		}
+#if ZERO_COPY_IMAGE_LOAD || (IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2))
+		/* The parent may have been mapped instead of loaded */
+		image_data->image_base = image_base;
+		image_data->h.attr = image_attr;
+#endif
+	}
+
+#if IMAGE_HASH_STREAMING
+	/* Hash the image while it is loaded if the parent allows it */
+	hash_stream = (auth_mod_hash_stream_start(image_id) == 0);
+#endif
+
+#if IMAGE_DECOMPRESS_STREAMING && defined(IMAGE_BL2)
+	/*
+	 * The compressed data is not kept once decompressed, so it can only be
+	 * authenticated by its hash calculated while it is read.
+	 */
+	if (((image_data->h.attr & IMAGE_ATTRIB_DECOMPRESS_STREAM) != 0U) &&
+	    !hash_stream) {
+		ERROR("Image id=%u cannot be authenticated while decompressed\n",
+		      image_id);
+		return -EAUTH;
 	}
+#endif
 
 	/* Load the image */
-	rc = load_image(image_id, image_data);
+	rc = load_image(image_id, image_data, hash_stream);
 	if (rc != 0) {
+#if IMAGE_HASH_STREAMING
+		auth_mod_hash_stream_abort();
+#endif
 		return rc;
 	}
 
@@ -201,7 +430,16 @@ static int load_auth_image_recursive(unsigned int image_id,
 	rc = auth_mod_verify_img(image_id,
 				 (void *)image_data->image_base,
 				 image_data->image_size);
+#if IMAGE_HASH_STREAMING
+	auth_mod_hash_stream_abort();
+#endif
 	if (rc != 0) {
+#if ZERO_COPY_IMAGE_LOAD
+		/* The storage of a mapped image cannot be wiped */
+		if ((image_data->h.attr & IMAGE_ATTRIB_ZERO_COPY) != 0U) {
+			return -EAUTH;
+		}
+#endif
 		/* Authentication error, zero memory and flush it right away. */
 		zero_normalmem((void *)image_data->image_base,
 			       image_data->image_size);
@@ -223,7 +461,7 @@ static int load_auth_image_internal(unsigned int image_id,
 	}
 #endif
 
-	return load_image(image_id, image_data);
+	return load_image(image_id, image_data, false);
 }
 
 /*******************************************************************************
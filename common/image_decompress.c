@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <arch_helpers.h>
@@ -17,6 +18,18 @@ static uint32_t decompressor_buf_size;
 static decompressor_t *decompressor;
 static struct image_info saved_image_info;
 
+#if IMAGE_DECOMPRESS_STREAMING
+/*
+ * Size of the chunks of compressed data read from the storage at a time. The
+ * rest of the temporary buffer is the workspace of the decompressor.
+ */
+#ifndef PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE
+#define PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE	U(0x4000)
+#endif
+
+static const decompressor_stream_t *decompressor_stream;
+#endif /* IMAGE_DECOMPRESS_STREAMING */
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *_decompressor)
 {
@@ -25,8 +38,83 @@ void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 	decompressor = _decompressor;
 }
 
+#if IMAGE_DECOMPRESS_STREAMING
+void image_decompress_stream_init(uintptr_t buf_base, uint32_t buf_size,
+				  const decompressor_stream_t *ops)
+{
+	assert(buf_size > PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE);
+
+	decompressor_buf_base = buf_base;
+	decompressor_buf_size = buf_size;
+	decompressor_stream = ops;
+}
+
+int image_decompress_stream_start(const struct image_info *info,
+				  uintptr_t *chunk_base, size_t *chunk_size)
+{
+	int ret;
+
+	ret = decompressor_stream->start(info->image_base,
+					 info->image_max_size,
+					 decompressor_buf_base +
+					 PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE,
+					 decompressor_buf_size -
+					 PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE);
+	if (ret) {
+		ERROR("Failed to start decompression (err=%d)\n", ret);
+		return ret;
+	}
+
+	*chunk_base = decompressor_buf_base;
+	*chunk_size = PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE;
+
+	return 0;
+}
+
+int image_decompress_stream_update(size_t len)
+{
+	int ret;
+
+	assert(len <= PLAT_IMAGE_DECOMPRESS_CHUNK_SIZE);
+
+	ret = decompressor_stream->update(decompressor_buf_base, len);
+	if (ret) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+	}
+
+	return ret;
+}
+
+int image_decompress_stream_finish(struct image_info *info)
+{
+	uintptr_t image_end;
+	int ret;
+
+	ret = decompressor_stream->finish(&image_end);
+	if (ret) {
+		ERROR("Failed to decompress image (err=%d)\n", ret);
+		return ret;
+	}
+
+	info->image_size = image_end - info->image_base;
+
+	return 0;
+}
+#endif /* IMAGE_DECOMPRESS_STREAMING */
+
 void image_decompress_prepare(struct image_info *info)
 {
+#if IMAGE_DECOMPRESS_STREAMING
+	/*
+	 * The compressed data is read in chunks into the temporary buffer and
+	 * decompressed straight to the final destination by load_image().
+	 */
+	if (decompressor_stream != NULL) {
+		info->h.attr |= IMAGE_ATTRIB_DECOMPRESS_STREAM;
+		return;
+	}
+#endif
+
 	/*
 	 * If the image is compressed, it should be loaded into the temporary
 	 * buffer instead of its final destination.  We save image_info, then
@@ -36,20 +124,41 @@ void image_decompress_prepare(struct image_info *info)
 	saved_image_info = *info;
 	info->image_base = decompressor_buf_base;
 	info->image_max_size = decompressor_buf_size;
+
+#if ZERO_COPY_IMAGE_LOAD
+	/*
+	 * The compressed data is only read by the decompressor, so it can be
+	 * consumed straight from memory-mapped storage if possible. In that
+	 * case load_image() leaves the temporary buffer untouched.
+	 */
+	info->h.attr |= IMAGE_ATTRIB_ZERO_COPY;
+#endif
 }
 
 int image_decompress(struct image_info *info)
 {
 	uintptr_t compressed_image_base, image_base, work_base;
 	uint32_t compressed_image_size, work_size;
+	bool mapped = false;
 	int ret;
 
+#if IMAGE_DECOMPRESS_STREAMING
+	/* The image has already been decompressed by load_image() */
+	if ((info->h.attr & IMAGE_ATTRIB_DECOMPRESS_STREAM) != 0U) {
+		info->h.attr &= ~IMAGE_ATTRIB_DECOMPRESS_STREAM;
+		return 0;
+	}
+#endif
+
 	/*
 	 * The size of compressed data has been filled by load_image().
 	 * Read it out before restoring image_info.
 	 */
 	compressed_image_size = info->image_size;
 	compressed_image_base = info->image_base;
+#if ZERO_COPY_IMAGE_LOAD
+	mapped = (info->h.attr & IMAGE_ATTRIB_ZERO_COPY) != 0U;
+#endif
 	*info = saved_image_info;
 
 	assert(compressed_image_size <= decompressor_buf_size);
@@ -59,9 +168,15 @@ int image_decompress(struct image_info *info)
 	/*
 	 * Use the rest of the temporary buffer as workspace of the
 	 * decompressor since the decompressor may need additional memory.
+	 * All of it is available if the compressed data has not been copied.
 	 */
-	work_base = compressed_image_base + compressed_image_size;
-	work_size = decompressor_buf_size - compressed_image_size;
+	if (mapped) {
+		work_base = decompressor_buf_base;
+		work_size = decompressor_buf_size;
+	} else {
+		work_base = compressed_image_base + compressed_image_size;
+		work_size = decompressor_buf_size - compressed_image_size;
+	}
 
 	ret = decompressor(&compressed_image_base, compressed_image_size,
 			   &image_base, info->image_max_size,
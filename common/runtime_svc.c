@@ -18,6 +18,7 @@
 #include <common/runtime_svc.h>
 #include <context.h>
 #include <lib/cpus/cpu_ops.h>
+#include <lib/pmf/pmf.h>
 #include <plat/common/platform.h>
 
 /*******************************************************************************
@@ -232,7 +233,13 @@ static void sync_handler(cpu_context_t *ctx, uint32_t smc_fid, u_register_t scr_
 
 	u_register_t x1, x2, x3, x4;
 	get_smc_params_from_ctx(ctx, x1, x2, x3, x4);
+#if ENABLE_SMC_LATENCY_HIST
+	pmf_smc_hist_start(smc_fid);
+#endif
 	handler(smc_fid, x1, x2, x3, x4, NULL, ctx, get_flags(smc_fid, scr_el3));
+#if ENABLE_SMC_LATENCY_HIST
+	pmf_smc_hist_end();
+#endif
 }
 
 void handler_sync_exception(cpu_context_t *ctx)
@@ -337,7 +344,17 @@ uintptr_t handle_runtime_svc(uint32_t smc_fid,
 
 	get_smc_params_from_ctx(handle, x1, x2, x3, x4);
 
+#if ENABLE_SMC_LATENCY_HIST
+	pmf_smc_hist_start(smc_fid);
+
+	uintptr_t ret = handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+
+	pmf_smc_hist_end();
+
+	return ret;
+#else
 	return handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
+#endif
 }
 
 /*******************************************************************************
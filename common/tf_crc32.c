@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2021-2025, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdarg.h>
 #include <assert.h>
+#include <string.h>
 
 #include <arm_acle.h>
 #include <common/debug.h>
@@ -17,6 +18,9 @@
  * Platforms with CPU ARMv8.0 should make sure to add a make switch
  * `ARM_ARCH_FEATURE := crc` for successful compilation of this file.
  *
+ * The buffer is processed 8 bytes at a time once its address is aligned, with
+ * the unaligned head and the tail processed byte by byte.
+ *
  * @crc: previous accumulated CRC
  * @buf: buffer base address
  * @size: the size of the buffer
@@ -30,9 +34,31 @@ uint32_t tf_crc32(uint32_t crc, const unsigned char *buf, size_t size)
 	uint32_t calc_crc = ~crc;
 	const unsigned char *local_buf = buf;
 	size_t local_size = size;
+	uint64_t dword;
+
+	/*
+	 * calculate CRC over byte data up to the first 8-byte aligned address
+	 */
+	while ((local_size != 0UL) &&
+	       (((uintptr_t)local_buf & (sizeof(uint64_t) - 1U)) != 0U)) {
+		calc_crc = __crc32b(calc_crc, *local_buf);
+		local_buf++;
+		local_size--;
+	}
+
+	/*
+	 * calculate CRC over aligned double words (little-endian, so each
+	 * double word is processed in memory order)
+	 */
+	while (local_size >= sizeof(uint64_t)) {
+		(void)memcpy(&dword, local_buf, sizeof(dword));
+		calc_crc = __crc32d(calc_crc, dword);
+		local_buf += sizeof(uint64_t);
+		local_size -= sizeof(uint64_t);
+	}
 
 	/*
-	 * calculate CRC over byte data
+	 * calculate CRC over the remaining byte data
 	 */
 	while (local_size != 0UL) {
 		calc_crc = __crc32b(calc_crc, *local_buf);
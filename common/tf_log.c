@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2019, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 #include <stdio.h>
 
 #include <common/debug.h>
+#include <common/tf_log_deferred.h>
 #include <plat/common/platform.h>
 
 /* Set the default maximum log level to the `LOG_LEVEL` build flag */
@@ -39,6 +40,25 @@ void tf_log(const char *fmt, ...)
 	}
 	prefix_str = plat_log_get_prefix(log_level);
 
+#if ENABLE_DEFERRED_LOG && defined(IMAGE_BL31)
+	/*
+	 * Errors and warnings are printed right away, after the messages this
+	 * CPU logged before them, so that they are not lost if a panic follows.
+	 */
+	if (log_level <= LOG_LEVEL_WARNING) {
+		tf_log_deferred_flush_local();
+	} else {
+		va_start(args, fmt);
+		bool deferred = tf_log_deferred_vprintf(prefix_str, fmt + 1,
+							args);
+		va_end(args);
+
+		if (deferred) {
+			return;
+		}
+	}
+#endif
+
 	while (*prefix_str != '\0') {
 		(void)putchar((int)*prefix_str);
 		prefix_str++;
@@ -61,6 +81,12 @@ void tf_log_newline(const char log_fmt[2])
 		return;
 	}
 
+#if ENABLE_DEFERRED_LOG && defined(IMAGE_BL31)
+	if ((log_level > LOG_LEVEL_WARNING) && tf_log_deferred_newline()) {
+		return;
+	}
+#endif
+
 	(void)putchar((int32_t)'\n');
 }
 
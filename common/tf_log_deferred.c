@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include <arch_helpers.h>
+#include <common/debug.h>
+#include <common/tf_log_deferred.h>
+#include <lib/per_cpu/per_cpu.h>
+#include <lib/spinlock.h>
+#include <lib/utils.h>
+#include <plat/common/platform.h>
+
+#define LOG_RING_MASK		((uint64_t)PLAT_LOG_DEFERRED_RING_SIZE - 1ULL)
+
+/* Number of bytes copied out of a ring at a time when flushing it */
+#define LOG_FLUSH_CHUNK		U(64)
+
+#ifdef PLAT_LOG_DEFERRED_RING_BASE
+/*
+ * The platform provides memory that the normal world can read to hold the
+ * rings, one per CPU in core position order.
+ */
+static tf_log_ring_t *get_log_ring(unsigned int cpu)
+{
+	return &((tf_log_ring_t *)PLAT_LOG_DEFERRED_RING_BASE)[cpu];
+}
+#else
+static PER_CPU_DEFINE(tf_log_ring_t, log_ring);
+
+static tf_log_ring_t *get_log_ring(unsigned int cpu)
+{
+	return PER_CPU_BY_INDEX(log_ring, cpu);
+}
+#endif /* PLAT_LOG_DEFERRED_RING_BASE */
+
+static bool log_deferred;
+
+/* Serialise the flushes of each ring. Writers never take them. */
+static spinlock_t log_flush_lock[PLATFORM_CORE_COUNT];
+
+/* Index of the next byte of each ring to write to the console */
+static uint64_t log_flush_idx[PLATFORM_CORE_COUNT];
+
+/*
+ * Set while a CPU writes to or flushes a ring, so that a message logged by an
+ * exception handler which interrupted it is printed directly instead.
+ */
+static volatile bool log_busy[PLATFORM_CORE_COUNT];
+
+static bool log_enter(unsigned int cpu)
+{
+	if (log_busy[cpu]) {
+		return false;
+	}
+
+	log_busy[cpu] = true;
+
+	return true;
+}
+
+static void log_exit(unsigned int cpu)
+{
+	log_busy[cpu] = false;
+}
+
+/*
+ * Append a message to the ring of the current CPU, overwriting the oldest
+ * messages if there is not enough space left.
+ */
+static void log_ring_write(unsigned int cpu, const char *msg, size_t len)
+{
+	tf_log_ring_t *ring = get_log_ring(cpu);
+	uint64_t idx = ring->commit_idx;
+	size_t i;
+
+	assert(len <= PLAT_LOG_DEFERRED_RING_SIZE);
+
+	/* Let readers know these bytes are about to be overwritten */
+	ring->reserve_idx = idx + len;
+	dmbish();
+
+	for (i = 0U; i < len; i++) {
+		ring->buf[(idx + i) & LOG_RING_MASK] = msg[i];
+	}
+
+	/* Make the message visible before publishing it */
+	dmbish();
+	ring->commit_idx = idx + len;
+}
+
+/*
+ * Format a log message into the ring of the current CPU instead of printing it.
+ * Returns false when deferred logging has not started yet or when the CPU was
+ * interrupted while using its ring, in which case the caller must print the
+ * message itself.
+ */
+bool tf_log_deferred_vprintf(const char *prefix, const char *fmt,
+			     va_list args)
+{
+	char msg[TF_LOG_DEFERRED_MSG_MAX];
+	unsigned int cpu;
+	size_t len = 0U;
+	int ret;
+
+	if (!log_deferred) {
+		return false;
+	}
+
+	cpu = plat_my_core_pos();
+	if (!log_enter(cpu)) {
+		return false;
+	}
+
+	while ((*prefix != '\0') && (len < (sizeof(msg) - 1U))) {
+		msg[len] = *prefix;
+		prefix++;
+		len++;
+	}
+
+	ret = vsnprintf(&msg[len], sizeof(msg) - len, fmt, args);
+	if (ret > 0) {
+		if ((size_t)ret < (sizeof(msg) - len)) {
+			len += (size_t)ret;
+		} else {
+			/* Truncated, end the line so the next message is not garbled */
+			len = sizeof(msg) - 1U;
+			msg[len - 1U] = '\n';
+		}
+	}
+
+	log_ring_write(cpu, msg, len);
+	log_exit(cpu);
+
+	return true;
+}
+
+bool tf_log_deferred_newline(void)
+{
+	unsigned int cpu;
+
+	if (!log_deferred) {
+		return false;
+	}
+
+	cpu = plat_my_core_pos();
+	if (!log_enter(cpu)) {
+		return false;
+	}
+
+	log_ring_write(cpu, "\n", 1U);
+	log_exit(cpu);
+
+	return true;
+}
+
+/*
+ * Switch BL31 to deferred logging. Called by the primary CPU at the end of the
+ * cold boot, before the other CPUs are brought up.
+ */
+void tf_log_deferred_start(void)
+{
+	unsigned int cpu;
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		zeromem(get_log_ring(cpu), sizeof(tf_log_ring_t));
+		log_flush_idx[cpu] = 0ULL;
+	}
+
+	dmbish();
+	log_deferred = true;
+}
+
+/* Write the messages a CPU has logged since the previous flush to the console */
+static void log_ring_flush(unsigned int cpu)
+{
+	const tf_log_ring_t *ring = get_log_ring(cpu);
+	uint64_t idx, commit_idx, reserve_idx, lost = 0ULL;
+	char chunk[LOG_FLUSH_CHUNK];
+	size_t len, i;
+
+	spin_lock(&log_flush_lock[cpu]);
+
+	idx = log_flush_idx[cpu];
+	for (;;) {
+		commit_idx = ring->commit_idx;
+		if (commit_idx == idx) {
+			break;
+		}
+
+		/* Read the index before the message it publishes */
+		dmbish();
+
+		if ((commit_idx - idx) > PLAT_LOG_DEFERRED_RING_SIZE) {
+			lost += commit_idx - PLAT_LOG_DEFERRED_RING_SIZE - idx;
+			idx = commit_idx - PLAT_LOG_DEFERRED_RING_SIZE;
+		}
+
+		len = (size_t)MIN(commit_idx - idx, (uint64_t)sizeof(chunk));
+		for (i = 0U; i < len; i++) {
+			chunk[i] = ring->buf[(idx + i) & LOG_RING_MASK];
+		}
+
+		/*
+		 * The CPU may have carried on logging while the chunk was being
+		 * copied. Drop the part of it which may have been overwritten.
+		 */
+		dmbish();
+		reserve_idx = ring->reserve_idx;
+		if ((reserve_idx - idx) > PLAT_LOG_DEFERRED_RING_SIZE) {
+			lost += reserve_idx - PLAT_LOG_DEFERRED_RING_SIZE - idx;
+			idx = reserve_idx - PLAT_LOG_DEFERRED_RING_SIZE;
+			continue;
+		}
+
+		for (i = 0U; i < len; i++) {
+			(void)putchar((int)chunk[i]);
+		}
+		idx += len;
+	}
+
+	log_flush_idx[cpu] = idx;
+
+	if (lost != 0ULL) {
+		(void)printf("CPU%u: %llu bytes of log lost\n", cpu,
+			     (unsigned long long)lost);
+	}
+
+	spin_unlock(&log_flush_lock[cpu]);
+}
+
+/*
+ * Write the messages logged by all CPUs since the previous flush to the
+ * console. Meant to be called by the platform at a point where the time spent
+ * printing does not matter, e.g. from the primary CPU while it is otherwise
+ * idle. The messages of each CPU are printed in order, but those of different
+ * CPUs are not interleaved in the order they were logged.
+ */
+void tf_log_deferred_flush(void)
+{
+	unsigned int my_cpu, cpu;
+
+	if (!log_deferred) {
+		return;
+	}
+
+	my_cpu = plat_my_core_pos();
+	if (!log_enter(my_cpu)) {
+		return;
+	}
+
+	for (cpu = 0U; cpu < PLATFORM_CORE_COUNT; cpu++) {
+		log_ring_flush(cpu);
+	}
+
+	log_exit(my_cpu);
+}
+
+/*
+ * Write the messages logged by the current CPU since the previous flush to the
+ * console. Called before printing an error or a warning, and by PSCI when the
+ * CPU is about to be suspended or turned off.
+ */
+void tf_log_deferred_flush_local(void)
+{
+	unsigned int cpu;
+
+	if (!log_deferred) {
+		return;
+	}
+
+	cpu = plat_my_core_pos();
+	if (!log_enter(cpu)) {
+		return;
+	}
+
+	log_ring_flush(cpu);
+	log_exit(cpu);
+}
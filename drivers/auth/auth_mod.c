@@ -28,6 +28,19 @@
 
 #pragma weak plat_set_nv_ctr2
 
+#if IMAGE_HASH_STREAMING
+/*
+ * State of the image hash being calculated while the image is loaded
+ */
+static struct {
+	bool active;
+	unsigned int img_id;
+	bool detached;
+	void *data_ptr;
+	unsigned int data_len;
+} hash_stream;
+#endif /* IMAGE_HASH_STREAMING */
+
 static int cmp_auth_param_type_desc(const auth_param_type_desc_t *a,
 		const auth_param_type_desc_t *b)
 {
@@ -114,6 +127,26 @@ static int auth_hash(const auth_method_param_hash_t *param,
 		return rc;
 	}
 
+#if IMAGE_HASH_STREAMING
+	/*
+	 * If the whole data has already been hashed while the image was being
+	 * loaded, only the final comparison remains to be done.
+	 */
+	if (hash_stream.active && (hash_stream.img_id == img_desc->img_id) &&
+	    (hash_stream.data_ptr == data_ptr) &&
+	    (hash_stream.data_len == data_len)) {
+		hash_stream.active = false;
+		rc = crypto_mod_verify_hash_finish();
+		if (rc != 0) {
+			VERBOSE("[TBB] %s():%d failed with error code %d.\n",
+				__func__, __LINE__, rc);
+			return rc;
+		}
+
+		return 0;
+	}
+#endif /* IMAGE_HASH_STREAMING */
+
 	/* Ask the crypto module to verify this hash */
 	rc = crypto_mod_verify_hash(data_ptr, data_len,
 				    hash_der_ptr, hash_der_len);
@@ -449,6 +482,158 @@ int auth_mod_get_parent_id(unsigned int img_id, unsigned int *parent_id)
 	return 0;
 }
 
+#if IMAGE_HASH_STREAMING
+/*
+ * Start hashing an image while it is being loaded. This is only possible for
+ * raw images authenticated by hash, once their parent has been authenticated.
+ *
+ * Return value:
+ *   0 = The image data must be passed to auth_mod_hash_stream_update() as it
+ *       is loaded, Otherwise = The image will be hashed when authenticated
+ */
+int auth_mod_hash_stream_start(unsigned int img_id)
+{
+	const auth_img_desc_t *img_desc = NULL;
+	const auth_method_desc_t *auth_method = NULL;
+	void *hash_der_ptr;
+	unsigned int hash_der_len;
+	int rc, i;
+
+	auth_mod_hash_stream_abort();
+
+	/* Get the image descriptor */
+	img_desc = FCONF_GET_PROPERTY(tbbr, cot, img_id);
+
+	if ((img_desc->img_type != IMG_RAW) || (img_desc->parent == NULL) ||
+	    (img_desc->img_auth_methods == NULL)) {
+		return 1;
+	}
+
+	if ((auth_img_flags[img_desc->parent->img_id] &
+	     IMG_FLAG_AUTHENTICATED) == 0U) {
+		return 1;
+	}
+
+	for (i = 0 ; i < AUTH_METHOD_NUM ; i++) {
+		auth_method = &img_desc->img_auth_methods[i];
+		if (auth_method->type == AUTH_METHOD_HASH) {
+			break;
+		}
+	}
+
+	if (i == AUTH_METHOD_NUM) {
+		return 1;
+	}
+
+	/* Get the hash to match from the parent image */
+	rc = auth_get_param(auth_method->param.hash.hash, img_desc->parent,
+			    &hash_der_ptr, &hash_der_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = crypto_mod_verify_hash_start(hash_der_ptr, hash_der_len);
+	if (rc != 0) {
+		VERBOSE("[TBB] Hash streaming not available for image %u (%d)\n",
+			img_id, rc);
+		return rc;
+	}
+
+	hash_stream.active = true;
+	hash_stream.img_id = img_id;
+	hash_stream.detached = false;
+	hash_stream.data_ptr = NULL;
+	hash_stream.data_len = 0U;
+
+	return 0;
+}
+
+/*
+ * Hash the next chunk of the image being loaded. Chunks must be contiguous in
+ * memory and passed in order. If hashing fails, the stream is dropped and the
+ * image is hashed again in full when it is authenticated.
+ */
+void auth_mod_hash_stream_update(void *data_ptr, unsigned int data_len)
+{
+	if (!hash_stream.active || (data_len == 0U)) {
+		return;
+	}
+
+	if (hash_stream.detached) {
+		auth_mod_hash_stream_abort();
+		return;
+	}
+
+	if (hash_stream.data_ptr == NULL) {
+		hash_stream.data_ptr = data_ptr;
+	} else if ((uintptr_t)data_ptr != ((uintptr_t)hash_stream.data_ptr +
+					   hash_stream.data_len)) {
+		auth_mod_hash_stream_abort();
+		return;
+	}
+
+	if (crypto_mod_verify_hash_update(data_ptr, data_len) != 0) {
+		auth_mod_hash_stream_abort();
+		return;
+	}
+
+	hash_stream.data_len += data_len;
+}
+
+/*
+ * Hash the next chunk of an image that is not kept in memory as it is read,
+ * such as compressed data that is decompressed on the fly. The chunks do not
+ * need to be contiguous. Once the last one has been hashed, the hash must be
+ * bound to the image passed to auth_mod_verify_img() with
+ * auth_mod_hash_stream_bind().
+ */
+void auth_mod_hash_stream_consume(void *data_ptr, unsigned int data_len)
+{
+	if (!hash_stream.active || (data_len == 0U)) {
+		return;
+	}
+
+	if ((hash_stream.data_ptr != NULL) ||
+	    (crypto_mod_verify_hash_update(data_ptr, data_len) != 0)) {
+		auth_mod_hash_stream_abort();
+		return;
+	}
+
+	hash_stream.detached = true;
+}
+
+/*
+ * Use the hash of the chunks passed to auth_mod_hash_stream_consume() to
+ * authenticate the image at data_ptr. This image cannot be hashed again, so
+ * it fails authentication if the hash calculation has been dropped.
+ */
+void auth_mod_hash_stream_bind(void *data_ptr, unsigned int data_len)
+{
+	if (!hash_stream.active) {
+		return;
+	}
+
+	if (!hash_stream.detached) {
+		auth_mod_hash_stream_abort();
+		return;
+	}
+
+	hash_stream.data_ptr = data_ptr;
+	hash_stream.data_len = data_len;
+}
+
+/*
+ * Drop the hash calculation in progress, if any
+ */
+void auth_mod_hash_stream_abort(void)
+{
+	if (hash_stream.active) {
+		hash_stream.active = false;
+		(void)crypto_mod_verify_hash_finish();
+	}
+}
+#endif /* IMAGE_HASH_STREAMING */
+
 /*
  * Initialize the different modules in the authentication framework
  */
@@ -593,3 +778,222 @@ int auth_mod_verify_img(unsigned int img_id,
 
 	return 0;
 }
+
+#if AUTH_CERT_HANDOFF
+/*
+ * Layout of the parameters extracted from authenticated certificates and
+ * handed over to a later boot stage. Each certificate is described by an
+ * auth_handoff_img header followed by 'num_params' parameters. Each parameter
+ * is an auth_handoff_param header followed by the OID of the parameter and by
+ * its data, padded to a multiple of 4 bytes.
+ */
+struct auth_handoff_img {
+	uint16_t img_id;
+	uint16_t num_params;
+};
+
+struct auth_handoff_param {
+	uint8_t type;
+	uint8_t oid_len;
+	uint16_t data_len;
+};
+
+#define AUTH_HANDOFF_ALIGN		U(4)
+
+static void auth_handoff_write(uint8_t *buf, size_t size, size_t offset,
+			       const void *src, size_t len)
+{
+	if ((buf != NULL) && (offset <= size) && (len <= (size - offset))) {
+		(void)memcpy(buf + offset, src, len);
+	}
+}
+
+/*
+ * Write the parameters extracted from the certificates authenticated so far
+ * to 'buf', which is 'size' bytes long. Return the number of bytes needed to
+ * describe them, or 0 if they cannot be described. Nothing is written if
+ * 'buf' is NULL or too small, which allows the caller to find out the size to
+ * reserve first.
+ */
+size_t auth_mod_export_verified(void *buf, size_t size)
+{
+	const auth_img_desc_t *img_desc;
+	const auth_param_type_desc_t *type_desc;
+	struct auth_handoff_img img;
+	struct auth_handoff_param param;
+	const char *oid;
+	size_t offset = 0U;
+	size_t img_offset, oid_len;
+	unsigned int img_id, data_len;
+	int i;
+
+	for (img_id = 0U; img_id < cot_desc_size; img_id++) {
+		img_desc = cot_desc_ptr[img_id];
+		if ((img_desc == NULL) || (img_desc->img_type != IMG_CERT) ||
+		    (img_desc->authenticated_data == NULL) ||
+		    ((auth_img_flags[img_id] & IMG_FLAG_AUTHENTICATED) == 0U)) {
+			continue;
+		}
+
+		img.img_id = (uint16_t)img_id;
+		img.num_params = 0U;
+		img_offset = offset;
+		offset += sizeof(img);
+
+		for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+			type_desc = img_desc->authenticated_data[i].type_desc;
+			if (type_desc == NULL) {
+				continue;
+			}
+
+			oid = type_desc->cookie;
+			oid_len = (oid != NULL) ? strlen(oid) : 0U;
+			data_len = img_desc->authenticated_data[i].data.len;
+			if ((oid_len > UINT8_MAX) || (data_len > UINT16_MAX)) {
+				return 0U;
+			}
+
+			param.type = (uint8_t)type_desc->type;
+			param.oid_len = (uint8_t)oid_len;
+			param.data_len = (uint16_t)data_len;
+
+			auth_handoff_write(buf, size, offset, &param,
+					   sizeof(param));
+			offset += sizeof(param);
+			auth_handoff_write(buf, size, offset, oid, oid_len);
+			offset += oid_len;
+			auth_handoff_write(buf, size, offset,
+				img_desc->authenticated_data[i].data.ptr,
+				data_len);
+			offset = round_up(offset + data_len, AUTH_HANDOFF_ALIGN);
+			img.num_params++;
+		}
+
+		auth_handoff_write(buf, size, img_offset, &img, sizeof(img));
+	}
+
+	return offset;
+}
+
+/*
+ * Copy a parameter handed over by an earlier boot stage into the matching
+ * parameter of the image descriptor. Return the index of that parameter, or
+ * -1 if there is none.
+ */
+static int auth_import_param(const auth_img_desc_t *img_desc,
+			     const struct auth_handoff_param *param,
+			     const uint8_t *oid, const uint8_t *data)
+{
+	const auth_param_type_desc_t *type_desc;
+	const char *cookie;
+	int i;
+
+	for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+		type_desc = img_desc->authenticated_data[i].type_desc;
+		if ((type_desc == NULL) ||
+		    ((unsigned int)type_desc->type != param->type)) {
+			continue;
+		}
+
+		cookie = type_desc->cookie;
+		if (cookie == NULL) {
+			if (param->oid_len != 0U) {
+				continue;
+			}
+		} else if ((strlen(cookie) != param->oid_len) ||
+			   (memcmp(cookie, oid, param->oid_len) != 0)) {
+			continue;
+		}
+
+		if (param->data_len > img_desc->authenticated_data[i].data.len) {
+			return -1;
+		}
+
+		(void)memcpy((void *)img_desc->authenticated_data[i].data.ptr,
+			     data, param->data_len);
+		return i;
+	}
+
+	return -1;
+}
+
+/*
+ * Import the parameters of the certificates authenticated by an earlier boot
+ * stage, as written by auth_mod_export_verified(). A certificate of the CoT is
+ * marked as authenticated once all of its parameters have been imported, so
+ * that it is not loaded and authenticated again when one of its children is.
+ * The buffer must come from a trusted source, as its contents are not
+ * authenticated. Return 0 on success.
+ */
+int auth_mod_import_verified(const void *buf, size_t len)
+{
+	const uint8_t *ptr = buf;
+	const auth_img_desc_t *img_desc;
+	struct auth_handoff_img img;
+	struct auth_handoff_param param;
+	size_t offset = 0U;
+	size_t param_size;
+	unsigned int n, imported, expected;
+	int i;
+
+	while ((len - offset) >= sizeof(img)) {
+		(void)memcpy(&img, ptr + offset, sizeof(img));
+		offset += sizeof(img);
+
+		img_desc = NULL;
+		if (img.img_id < cot_desc_size) {
+			img_desc = cot_desc_ptr[img.img_id];
+		}
+		if ((img_desc != NULL) && ((img_desc->img_type != IMG_CERT) ||
+		    (img_desc->authenticated_data == NULL))) {
+			img_desc = NULL;
+		}
+
+		imported = 0U;
+		for (n = 0U; n < img.num_params; n++) {
+			if ((len - offset) < sizeof(param)) {
+				return 1;
+			}
+			(void)memcpy(&param, ptr + offset, sizeof(param));
+
+			param_size = round_up(sizeof(param) + param.oid_len +
+					      param.data_len,
+					      AUTH_HANDOFF_ALIGN);
+			if ((len - offset) < param_size) {
+				return 1;
+			}
+
+			if (img_desc != NULL) {
+				i = auth_import_param(img_desc, &param,
+					ptr + offset + sizeof(param),
+					ptr + offset + sizeof(param) +
+					param.oid_len);
+				if (i >= 0) {
+					imported |= 1U << i;
+				}
+			}
+
+			offset += param_size;
+		}
+
+		if (img_desc == NULL) {
+			continue;
+		}
+
+		expected = 0U;
+		for (i = 0 ; i < COT_MAX_VERIFIED_PARAMS ; i++) {
+			if (img_desc->authenticated_data[i].type_desc != NULL) {
+				expected |= 1U << i;
+			}
+		}
+
+		if (imported == expected) {
+			auth_img_flags[img.img_id] |= IMG_FLAG_AUTHENTICATED;
+			VERBOSE("[TBB] image %u authenticated by an earlier stage\n",
+				img.img_id);
+		}
+	}
+
+	return (offset == len) ? 0 : 1;
+}
+#endif /* AUTH_CERT_HANDOFF */
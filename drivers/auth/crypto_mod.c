@@ -120,6 +120,60 @@ int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 	return crypto_lib_desc.verify_hash(data_ptr, data_len,
 					   digest_info_ptr, digest_info_len);
 }
+
+/*
+ * Start an incremental hash verification
+ *
+ * Parameters:
+ *
+ *   digest_info_ptr, digest_info_len: hash to be compared
+ *
+ * Returns CRYPTO_ERR_UNKNOWN if the library does not support incremental hash
+ * verification, in which case the caller is expected to fall back on
+ * crypto_mod_verify_hash().
+ */
+int crypto_mod_verify_hash_start(void *digest_info_ptr,
+				 unsigned int digest_info_len)
+{
+	assert(digest_info_ptr != NULL);
+	assert(digest_info_len != 0);
+
+	if ((crypto_lib_desc.verify_hash_start == NULL) ||
+	    (crypto_lib_desc.verify_hash_update == NULL) ||
+	    (crypto_lib_desc.verify_hash_finish == NULL)) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	return crypto_lib_desc.verify_hash_start(digest_info_ptr,
+						 digest_info_len);
+}
+
+/*
+ * Feed data to the incremental hash verification in progress
+ *
+ * Parameters:
+ *
+ *   data_ptr, data_len: next chunk of data to be hashed
+ */
+int crypto_mod_verify_hash_update(void *data_ptr, unsigned int data_len)
+{
+	assert(data_ptr != NULL);
+	assert(data_len != 0);
+	assert(crypto_lib_desc.verify_hash_update != NULL);
+
+	return crypto_lib_desc.verify_hash_update(data_ptr, data_len);
+}
+
+/*
+ * Complete the incremental hash verification in progress and compare the
+ * resulting hash with the one provided to crypto_mod_verify_hash_start()
+ */
+int crypto_mod_verify_hash_finish(void)
+{
+	assert(crypto_lib_desc.verify_hash_finish != NULL);
+
+	return crypto_lib_desc.verify_hash_finish();
+}
 #endif /* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY || \
 	  CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
 
@@ -218,6 +272,75 @@ int crypto_mod_auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 					    tag_len);
 }
 
+/*
+ * Start an incremental authenticated decryption
+ *
+ * Parameters:
+ *
+ *   dec_algo: authenticated decryption algorithm
+ *   len: total length of the data to be decrypted
+ *   key, key_len, key_flags: symmetric decryption key
+ *   iv, iv_len: initialization vector
+ *   tag, tag_len: authentication tag
+ *
+ * Returns CRYPTO_ERR_UNKNOWN if the library does not support incremental
+ * decryption, in which case the caller is expected to fall back on
+ * crypto_mod_auth_decrypt().
+ */
+int crypto_mod_auth_decrypt_start(enum crypto_dec_algo dec_algo, size_t len,
+				  const void *key, unsigned int key_len,
+				  unsigned int key_flags, const void *iv,
+				  unsigned int iv_len, const void *tag,
+				  unsigned int tag_len)
+{
+	if ((crypto_lib_desc.auth_decrypt_start == NULL) ||
+	    (crypto_lib_desc.auth_decrypt_update == NULL) ||
+	    (crypto_lib_desc.auth_decrypt_finish == NULL)) {
+		return CRYPTO_ERR_UNKNOWN;
+	}
+
+	if ((len == 0U) || (key == NULL) || (key_len == 0U) || (iv == NULL) ||
+	    (iv_len == 0U) || (iv_len > CRYPTO_MAX_IV_SIZE) || (tag == NULL) ||
+	    (tag_len == 0U) || (tag_len > CRYPTO_MAX_TAG_SIZE)) {
+		WARN("Invalid parameters for authenticated decryption\n");
+		return CRYPTO_ERR_DECRYPTION;
+	}
+
+	return crypto_lib_desc.auth_decrypt_start(dec_algo, len, key, key_len,
+						  key_flags, iv, iv_len, tag,
+						  tag_len);
+}
+
+/*
+ * Decrypt in place the next chunk of data of the incremental authenticated
+ * decryption in progress. All the chunks but the last one must be a multiple
+ * of 16 bytes long.
+ *
+ * Parameters:
+ *
+ *   data_ptr, len: next chunk of data to be decrypted (inout param)
+ */
+int crypto_mod_auth_decrypt_update(void *data_ptr, size_t len)
+{
+	assert(data_ptr != NULL);
+	assert(len != 0U);
+	assert(crypto_lib_desc.auth_decrypt_update != NULL);
+
+	return crypto_lib_desc.auth_decrypt_update(data_ptr, len);
+}
+
+/*
+ * Complete the incremental authenticated decryption in progress and check the
+ * authentication tag provided to crypto_mod_auth_decrypt_start(). The data
+ * decrypted so far must not be used if this fails.
+ */
+int crypto_mod_auth_decrypt_finish(void)
+{
+	assert(crypto_lib_desc.auth_decrypt_finish != NULL);
+
+	return crypto_lib_desc.auth_decrypt_finish();
+}
+
 /* Perform end of psa crypto usage calls to finish */
 void crypto_mod_finish(void)
 {
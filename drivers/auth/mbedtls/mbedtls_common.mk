@@ -34,6 +34,14 @@ $(eval $(call add_define,MBEDTLS_CONFIG_FILE))
 
 MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/mbedtls_common.c
 
+# When the Cryptographic Extension is checked at runtime, mbed TLS queries it
+# through getauxval().
+ifeq (${ARCH},aarch64)
+ifneq ($(filter 2,${ENABLE_FEAT_CRYPTO} ${ENABLE_FEAT_CRYPTO_SHA3}),)
+MBEDTLS_SOURCES	+=		drivers/auth/mbedtls/mbedtls_sha2.c
+endif
+endif
+
 LIBMBEDTLS_SRCS		+= $(addprefix ${MBEDTLS_DIR}/library/,		\
 					aes.c 				\
 					aesce.c				\
@@ -144,6 +152,10 @@ else
     $(error "TF_MBEDTLS_KEY_ALG=${TF_MBEDTLS_KEY_ALG} not supported on mbed TLS")
 endif
 
+# Number of public keys that the mbed TLS crypto module keeps parsed between
+# signature verifications. 0 disables the cache.
+TF_MBEDTLS_PK_CACHE_ENTRIES	?=	0
+
 TF_MBEDTLS_USE_AES_CCM	:=	0
 TF_MBEDTLS_USE_AES_GCM	:=	0
 
@@ -159,11 +171,12 @@ $(call add_defines,\
         TF_MBEDTLS_KEY_ALG_ID \
         TF_MBEDTLS_KEY_SIZE \
         TF_MBEDTLS_HASH_ALG_ID \
+        TF_MBEDTLS_PK_CACHE_ENTRIES \
         TF_MBEDTLS_USE_AES_CCM \
         TF_MBEDTLS_USE_AES_GCM \
 ))
 
-ifeq ($(filter 1,$(ENABLE_FEAT_CRYPTO)),1)
+ifneq ($(filter 1 2,$(ENABLE_FEAT_CRYPTO)),)
     REMOVED_CFLAGS		:=	-nostdinc -mgeneral-regs-only
     $(eval $(call MAKE_LIB,mbedtls,${REMOVED_CFLAGS}))
 else
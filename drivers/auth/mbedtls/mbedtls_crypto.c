@@ -5,6 +5,7 @@
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 
@@ -19,6 +20,7 @@
 #include <mbedtls/x509.h>
 
 #include <common/debug.h>
+#include <common/tbbr/cot_def.h>
 #include <drivers/auth/crypto_mod.h>
 #include <drivers/auth/mbedtls/mbedtls_common.h>
 
@@ -78,6 +80,68 @@ int mbedtls_x509_get_sig_alg(const mbedtls_x509_buf *sig_oid,
 			     mbedtls_md_type_t *md_alg,
 			     mbedtls_pk_type_t *pk_alg,
 			     void **sig_opts);
+
+#if TF_MBEDTLS_PK_CACHE_ENTRIES
+/*
+ * Public keys kept parsed between signature verifications. The certificates of
+ * a CoT are signed with a handful of keys (ROTPK, trusted world key, ...), so
+ * this avoids parsing the same key again for each certificate. It also lets
+ * mbed TLS reuse the values it computes on the first use of a key, i.e. the
+ * Montgomery constant of an RSA modulus and the comb table of the generator of
+ * an EC group. The contexts are allocated from the mbed TLS heap and are only
+ * freed when replaced by the context of another key.
+ */
+static struct {
+	mbedtls_pk_context pk;
+	unsigned int der_len;
+	unsigned char der[PK_DER_LEN];
+} pk_cache[TF_MBEDTLS_PK_CACHE_ENTRIES];
+static unsigned int pk_cache_next;
+
+/*
+ * Return the cached context of a public key, parsing it first if needed.
+ * Return NULL if the key cannot be cached.
+ */
+static mbedtls_pk_context *pk_cache_get(void *pk_ptr, unsigned int pk_len)
+{
+	mbedtls_pk_context *pk;
+	unsigned char *p, *end;
+	unsigned int i;
+
+	if (pk_len > sizeof(pk_cache[0].der)) {
+		return NULL;
+	}
+
+	for (i = 0U; i < ARRAY_SIZE(pk_cache); i++) {
+		if ((pk_cache[i].der_len == pk_len) &&
+		    (memcmp(pk_cache[i].der, pk_ptr, pk_len) == 0)) {
+			return &pk_cache[i].pk;
+		}
+	}
+
+	/* Replace the least recently added entry */
+	i = pk_cache_next;
+	pk_cache_next = (i + 1U) % ARRAY_SIZE(pk_cache);
+
+	pk = &pk_cache[i].pk;
+	mbedtls_pk_free(pk);
+	pk_cache[i].der_len = 0U;
+
+	mbedtls_pk_init(pk);
+	p = (unsigned char *)pk_ptr;
+	end = (unsigned char *)(p + pk_len);
+	if (mbedtls_pk_parse_subpubkey(&p, end, pk) != 0) {
+		mbedtls_pk_free(pk);
+		return NULL;
+	}
+
+	(void)memcpy(pk_cache[i].der, pk_ptr, pk_len);
+	pk_cache[i].der_len = pk_len;
+
+	return pk;
+}
+#endif /* TF_MBEDTLS_PK_CACHE_ENTRIES */
+
 /*
  * Verify a signature.
  *
@@ -93,7 +157,8 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 	mbedtls_asn1_buf signature;
 	mbedtls_md_type_t md_alg;
 	mbedtls_pk_type_t pk_alg;
-	mbedtls_pk_context pk = {0};
+	mbedtls_pk_context pk_local = {0};
+	mbedtls_pk_context *pk = NULL;
 	int rc;
 	void *sig_opts = NULL;
 	const mbedtls_md_info_t *md_info;
@@ -114,14 +179,20 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 		return CRYPTO_ERR_SIGNATURE;
 	}
 
-	/* Parse the public key */
-	mbedtls_pk_init(&pk);
-	p = (unsigned char *)pk_ptr;
-	end = (unsigned char *)(p + pk_len);
-	rc = mbedtls_pk_parse_subpubkey(&p, end, &pk);
-	if (rc != 0) {
-		rc = CRYPTO_ERR_SIGNATURE;
-		goto end2;
+	/* Parse the public key, unless it has been parsed already */
+#if TF_MBEDTLS_PK_CACHE_ENTRIES
+	pk = pk_cache_get(pk_ptr, pk_len);
+#endif
+	if (pk == NULL) {
+		pk = &pk_local;
+		mbedtls_pk_init(pk);
+		p = (unsigned char *)pk_ptr;
+		end = (unsigned char *)(p + pk_len);
+		rc = mbedtls_pk_parse_subpubkey(&p, end, pk);
+		if (rc != 0) {
+			rc = CRYPTO_ERR_SIGNATURE;
+			goto end2;
+		}
 	}
 
 	/* Get the signature (bitstring) */
@@ -149,7 +220,7 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 	}
 
 	/* Verify the signature */
-	rc = mbedtls_pk_verify_ext(pk_alg, sig_opts, &pk, md_alg, hash,
+	rc = mbedtls_pk_verify_ext(pk_alg, sig_opts, pk, md_alg, hash,
 			mbedtls_md_get_size(md_info),
 			signature.p, signature.len);
 	if (rc != 0) {
@@ -161,26 +232,29 @@ static int verify_signature(void *data_ptr, unsigned int data_len,
 	rc = CRYPTO_SUCCESS;
 
 end1:
-	mbedtls_pk_free(&pk);
+	if (pk == &pk_local) {
+		mbedtls_pk_free(pk);
+	}
 end2:
 	mbedtls_free(sig_opts);
 	return rc;
 }
 
 /*
- * Match a hash
+ * Parse a DigestInfo structure and return the message digest information and a
+ * pointer to the hash it contains.
  *
  * Digest info is passed in DER format following the ASN.1 structure detailed
  * above.
  */
-static int verify_hash(void *data_ptr, unsigned int data_len,
-		       void *digest_info_ptr, unsigned int digest_info_len)
+static int get_digest_info(void *digest_info_ptr, unsigned int digest_info_len,
+			   const mbedtls_md_info_t **md_info_out,
+			   unsigned char **hash_out)
 {
 	mbedtls_asn1_buf hash_oid, params;
 	mbedtls_md_type_t md_alg;
 	const mbedtls_md_info_t *md_info;
-	unsigned char *p, *end, *hash;
-	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	unsigned char *p, *end;
 	size_t len;
 	int rc;
 
@@ -225,7 +299,31 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 	if (len != mbedtls_md_get_size(md_info)) {
 		return CRYPTO_ERR_HASH;
 	}
-	hash = p;
+
+	*md_info_out = md_info;
+	*hash_out = p;
+
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Match a hash
+ *
+ * Digest info is passed in DER format following the ASN.1 structure detailed
+ * above.
+ */
+static int verify_hash(void *data_ptr, unsigned int data_len,
+		       void *digest_info_ptr, unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *p, *hash;
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
 
 	/* Calculate the hash of the data */
 	p = (unsigned char *)data_ptr;
@@ -242,6 +340,99 @@ static int verify_hash(void *data_ptr, unsigned int data_len,
 
 	return CRYPTO_SUCCESS;
 }
+
+/*
+ * State of the incremental hash verification in progress
+ */
+static mbedtls_md_context_t stream_md_ctx;
+static unsigned char stream_hash[MBEDTLS_MD_MAX_SIZE];
+static size_t stream_hash_len;
+static bool stream_active;
+
+/*
+ * Start an incremental hash verification. The expected hash is copied so that
+ * the DigestInfo buffer does not need to remain valid until the end of the
+ * operation.
+ */
+static int verify_hash_start(void *digest_info_ptr,
+			     unsigned int digest_info_len)
+{
+	const mbedtls_md_info_t *md_info;
+	unsigned char *hash;
+	int rc;
+
+	if (stream_active) {
+		/* Discard the operation that was not finished */
+		mbedtls_md_free(&stream_md_ctx);
+		stream_active = false;
+	}
+
+	rc = get_digest_info(digest_info_ptr, digest_info_len, &md_info, &hash);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+
+	stream_hash_len = mbedtls_md_get_size(md_info);
+	(void)memcpy(stream_hash, hash, stream_hash_len);
+
+	mbedtls_md_init(&stream_md_ctx);
+	rc = mbedtls_md_setup(&stream_md_ctx, md_info, 0);
+	if (rc != 0) {
+		mbedtls_md_free(&stream_md_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_md_starts(&stream_md_ctx);
+	if (rc != 0) {
+		mbedtls_md_free(&stream_md_ctx);
+		return CRYPTO_ERR_HASH;
+	}
+
+	stream_active = true;
+
+	return CRYPTO_SUCCESS;
+}
+
+static int verify_hash_update(void *data_ptr, unsigned int data_len)
+{
+	int rc;
+
+	if (!stream_active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_md_update(&stream_md_ctx, data_ptr, data_len);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
+
+static int verify_hash_finish(void)
+{
+	unsigned char data_hash[MBEDTLS_MD_MAX_SIZE];
+	int rc;
+
+	if (!stream_active) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	rc = mbedtls_md_finish(&stream_md_ctx, data_hash);
+	mbedtls_md_free(&stream_md_ctx);
+	stream_active = false;
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	/* Compare values */
+	rc = memcmp(data_hash, stream_hash, stream_hash_len);
+	if (rc != 0) {
+		return CRYPTO_ERR_HASH;
+	}
+
+	return CRYPTO_SUCCESS;
+}
 #endif /* CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY || \
 	  CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC */
 
@@ -306,139 +497,145 @@ static int calc_hash(enum crypto_md_algo md_algo, void *data_ptr,
  * be configured to balance stack usage vs execution speed.
  */
 #define DEC_OP_BUF_SIZE		128
+
+/*
+ * State of the incremental authenticated decryption in progress. Only one of
+ * CCM and GCM can be selected at a time.
+ */
+#if TF_MBEDTLS_USE_AES_CCM
+static mbedtls_ccm_context dec_ctx;
+#else
+static mbedtls_gcm_context dec_ctx;
 #endif
+static unsigned char dec_tag[CRYPTO_MAX_TAG_SIZE];
+static unsigned int dec_tag_len;
+static bool dec_active;
 
+static void auth_decrypt_free(void)
+{
 #if TF_MBEDTLS_USE_AES_CCM
-static int aes_ccm_decrypt(void *data_ptr, size_t len, const void *key,
-			   unsigned int key_len, const void *iv,
-			   unsigned int iv_len, const void *tag,
-			   unsigned int tag_len)
+	mbedtls_ccm_free(&dec_ctx);
+#else
+	mbedtls_gcm_free(&dec_ctx);
+#endif
+	dec_active = false;
+}
+
+/*
+ * Start an incremental authenticated decryption. The tag is copied so that
+ * its buffer does not need to remain valid until the end of the operation.
+ */
+static int auth_decrypt_start(enum crypto_dec_algo dec_algo, size_t len,
+			      const void *key, unsigned int key_len,
+			      unsigned int key_flags, const void *iv,
+			      unsigned int iv_len, const void *tag,
+			      unsigned int tag_len)
 {
-	mbedtls_ccm_context ctx;
 	mbedtls_cipher_id_t cipher = MBEDTLS_CIPHER_ID_AES;
-	unsigned char buf[DEC_OP_BUF_SIZE];
-	unsigned char tag_buf[CRYPTO_MAX_TAG_SIZE];
-	unsigned char *pt = data_ptr;
-	size_t dec_len;
-	int diff, i, rc;
-	size_t output_length;
+	int rc;
 
-	mbedtls_ccm_init(&ctx);
+	assert((key_flags & ENC_KEY_IS_IDENTIFIER) == 0);
 
-	rc = mbedtls_ccm_setkey(&ctx, cipher, key, key_len * 8);
-	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_ccm;
+	if (dec_active) {
+		/* Discard the operation that was not finished */
+		auth_decrypt_free();
 	}
 
-	rc = mbedtls_ccm_set_lengths(&ctx, 0, len, tag_len);
-	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_ccm;
+#if TF_MBEDTLS_USE_AES_CCM
+	if (dec_algo != CRYPTO_CCM_DECRYPT) {
+		return CRYPTO_ERR_DECRYPTION;
 	}
 
-#if (MBEDTLS_VERSION_MAJOR < 3)
-	rc = mbedtls_ccm_starts(&ctx, MBEDTLS_CCM_DECRYPT, iv, iv_len, NULL, 0);
-#else
-	rc = mbedtls_ccm_starts(&ctx, MBEDTLS_CCM_DECRYPT, iv, iv_len);
-#endif
+	mbedtls_ccm_init(&dec_ctx);
+
+	rc = mbedtls_ccm_setkey(&dec_ctx, cipher, key, key_len * 8);
 	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_ccm;
+		goto err_start;
 	}
 
-	while (len > 0) {
-		dec_len = MIN(sizeof(buf), len);
+	rc = mbedtls_ccm_set_lengths(&dec_ctx, 0, len, tag_len);
+	if (rc != 0) {
+		goto err_start;
+	}
 
 #if (MBEDTLS_VERSION_MAJOR < 3)
-		rc = mbedtls_ccm_update(&ctx, dec_len, pt, buf);
+	rc = mbedtls_ccm_starts(&dec_ctx, MBEDTLS_CCM_DECRYPT, iv, iv_len,
+				NULL, 0);
 #else
-		rc = mbedtls_ccm_update(&ctx, pt, dec_len, buf, sizeof(buf), &output_length);
+	rc = mbedtls_ccm_starts(&dec_ctx, MBEDTLS_CCM_DECRYPT, iv, iv_len);
 #endif
-
-		if (rc != 0) {
-			rc = CRYPTO_ERR_DECRYPTION;
-			goto exit_ccm;
-		}
-
-		assert(dec_len == output_length);
-
-		memcpy(pt, buf, dec_len);
-		pt += dec_len;
-		len -= dec_len;
+#else /* TF_MBEDTLS_USE_AES_GCM */
+	if (dec_algo != CRYPTO_GCM_DECRYPT) {
+		return CRYPTO_ERR_DECRYPTION;
 	}
 
-	rc = mbedtls_ccm_finish(&ctx, tag_buf, sizeof(tag_buf));
+	mbedtls_gcm_init(&dec_ctx);
 
+	rc = mbedtls_gcm_setkey(&dec_ctx, cipher, key, key_len * 8);
 	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_ccm;
+		goto err_start;
 	}
 
-	/* Check tag in "constant-time" */
-	for (diff = 0, i = 0; i < tag_len; i++) {
-		diff |= ((const unsigned char *)tag)[i] ^ tag_buf[i];
+#if (MBEDTLS_VERSION_MAJOR < 3)
+	rc = mbedtls_gcm_starts(&dec_ctx, MBEDTLS_GCM_DECRYPT, iv, iv_len,
+				NULL, 0);
+#else
+	rc = mbedtls_gcm_starts(&dec_ctx, MBEDTLS_GCM_DECRYPT, iv, iv_len);
+#endif
+#endif /* TF_MBEDTLS_USE_AES_CCM */
+	if (rc != 0) {
+		goto err_start;
 	}
 
-	if (diff != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_ccm;
-	}
+	(void)memcpy(dec_tag, tag, tag_len);
+	dec_tag_len = tag_len;
+	dec_active = true;
 
-	/* CCM decryption success */
-	rc = CRYPTO_SUCCESS;
+	return CRYPTO_SUCCESS;
 
-exit_ccm:
-	mbedtls_ccm_free(&ctx);
-	return rc;
+err_start:
+	auth_decrypt_free();
+	return CRYPTO_ERR_DECRYPTION;
 }
-#endif /* TF_MBEDTLS_USE_AES_CCM */
 
-#if TF_MBEDTLS_USE_AES_GCM
-static int aes_gcm_decrypt(void *data_ptr, size_t len, const void *key,
-			   unsigned int key_len, const void *iv,
-			   unsigned int iv_len, const void *tag,
-			   unsigned int tag_len)
+/*
+ * Decrypt in place the next chunk of data. A failure ends the operation.
+ */
+static int auth_decrypt_update(void *data_ptr, size_t len)
 {
-	mbedtls_gcm_context ctx;
-	mbedtls_cipher_id_t cipher = MBEDTLS_CIPHER_ID_AES;
 	unsigned char buf[DEC_OP_BUF_SIZE];
-	unsigned char tag_buf[CRYPTO_MAX_TAG_SIZE];
 	unsigned char *pt = data_ptr;
 	size_t dec_len;
-	int diff, i, rc;
 	size_t output_length __unused;
+	int rc;
 
-	mbedtls_gcm_init(&ctx);
-
-	rc = mbedtls_gcm_setkey(&ctx, cipher, key, key_len * 8);
-	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_gcm;
-	}
-
-#if (MBEDTLS_VERSION_MAJOR < 3)
-	rc = mbedtls_gcm_starts(&ctx, MBEDTLS_GCM_DECRYPT, iv, iv_len, NULL, 0);
-#else
-	rc = mbedtls_gcm_starts(&ctx, MBEDTLS_GCM_DECRYPT, iv, iv_len);
-#endif
-	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_gcm;
+	if (!dec_active) {
+		return CRYPTO_ERR_DECRYPTION;
 	}
 
 	while (len > 0) {
 		dec_len = MIN(sizeof(buf), len);
 
+#if TF_MBEDTLS_USE_AES_CCM
 #if (MBEDTLS_VERSION_MAJOR < 3)
-		rc = mbedtls_gcm_update(&ctx, dec_len, pt, buf);
+		rc = mbedtls_ccm_update(&dec_ctx, dec_len, pt, buf);
 #else
-		rc = mbedtls_gcm_update(&ctx, pt, dec_len, buf, sizeof(buf), &output_length);
+		rc = mbedtls_ccm_update(&dec_ctx, pt, dec_len, buf, sizeof(buf),
+					&output_length);
+		assert((rc != 0) || (dec_len == output_length));
 #endif
+#else /* TF_MBEDTLS_USE_AES_GCM */
+#if (MBEDTLS_VERSION_MAJOR < 3)
+		rc = mbedtls_gcm_update(&dec_ctx, dec_len, pt, buf);
+#else
+		rc = mbedtls_gcm_update(&dec_ctx, pt, dec_len, buf, sizeof(buf),
+					&output_length);
+#endif
+#endif /* TF_MBEDTLS_USE_AES_CCM */
 
 		if (rc != 0) {
-			rc = CRYPTO_ERR_DECRYPTION;
-			goto exit_gcm;
+			auth_decrypt_free();
+			return CRYPTO_ERR_DECRYPTION;
 		}
 
 		memcpy(pt, buf, dec_len);
@@ -446,36 +643,51 @@ static int aes_gcm_decrypt(void *data_ptr, size_t len, const void *key,
 		len -= dec_len;
 	}
 
-#if (MBEDTLS_VERSION_MAJOR < 3)
-	rc = mbedtls_gcm_finish(&ctx, tag_buf, sizeof(tag_buf));
+	return CRYPTO_SUCCESS;
+}
+
+/*
+ * Compute the tag of the decrypted data and compare it with the one provided
+ * when the operation was started.
+ */
+static int auth_decrypt_finish(void)
+{
+	unsigned char tag_buf[CRYPTO_MAX_TAG_SIZE];
+	size_t output_length __unused;
+	unsigned int i;
+	int diff, rc;
+
+	if (!dec_active) {
+		return CRYPTO_ERR_DECRYPTION;
+	}
+
+#if TF_MBEDTLS_USE_AES_CCM
+	rc = mbedtls_ccm_finish(&dec_ctx, tag_buf, sizeof(tag_buf));
+#elif (MBEDTLS_VERSION_MAJOR < 3)
+	rc = mbedtls_gcm_finish(&dec_ctx, tag_buf, sizeof(tag_buf));
 #else
-	rc = mbedtls_gcm_finish(&ctx, NULL, 0, &output_length, tag_buf, sizeof(tag_buf));
+	rc = mbedtls_gcm_finish(&dec_ctx, NULL, 0, &output_length, tag_buf,
+				sizeof(tag_buf));
 #endif
 
+	auth_decrypt_free();
+
 	if (rc != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_gcm;
+		return CRYPTO_ERR_DECRYPTION;
 	}
 
 	/* Check tag in "constant-time" */
-	for (diff = 0, i = 0; i < tag_len; i++)
-		diff |= ((const unsigned char *)tag)[i] ^ tag_buf[i];
+	for (diff = 0, i = 0U; i < dec_tag_len; i++) {
+		diff |= dec_tag[i] ^ tag_buf[i];
+	}
 
 	if (diff != 0) {
-		rc = CRYPTO_ERR_DECRYPTION;
-		goto exit_gcm;
+		return CRYPTO_ERR_DECRYPTION;
 	}
 
-	/* GCM decryption success */
-	rc = CRYPTO_SUCCESS;
-
-exit_gcm:
-	mbedtls_gcm_free(&ctx);
-	return rc;
+	return CRYPTO_SUCCESS;
 }
-#endif /* TF_MBEDTLS_USE_AES_GCM */
 
-#if TF_MBEDTLS_USE_AES_AEAD
 /*
  * Authenticated decryption of an image
  */
@@ -487,30 +699,18 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 {
 	int rc;
 
-	assert((key_flags & ENC_KEY_IS_IDENTIFIER) == 0);
+	rc = auth_decrypt_start(dec_algo, len, key, key_len, key_flags, iv,
+				iv_len, tag, tag_len);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
 
-	switch (dec_algo) {
-#if TF_MBEDTLS_USE_AES_CCM
-	case CRYPTO_CCM_DECRYPT:
-		rc = aes_ccm_decrypt(data_ptr, len, key, key_len, iv, iv_len,
-				     tag, tag_len);
-		if (rc != 0)
-			return rc;
-		break;
-#endif /* TF_MBEDTLS_USE_AES_CCM */
-#if TF_MBEDTLS_USE_AES_GCM
-	case CRYPTO_GCM_DECRYPT:
-		rc = aes_gcm_decrypt(data_ptr, len, key, key_len, iv, iv_len,
-				     tag, tag_len);
-		if (rc != 0)
-			return rc;
-		break;
-#endif /* TF_MBEDTLS_USE_AES_GCM */
-	default:
-		return CRYPTO_ERR_DECRYPTION;
+	rc = auth_decrypt_update(data_ptr, len);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
 	}
 
-	return CRYPTO_SUCCESS;
+	return auth_decrypt_finish();
 }
 #endif /* TF_MBEDTLS_USE_AES_AEAD */
 
@@ -519,19 +719,29 @@ static int auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
  */
 #if CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC
 #if TF_MBEDTLS_USE_AES_AEAD
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    auth_decrypt, NULL, NULL);
+REGISTER_CRYPTO_LIB_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+			   verify_hash_start, verify_hash_update,
+			   verify_hash_finish, calc_hash, auth_decrypt,
+			   auth_decrypt_start, auth_decrypt_update,
+			   auth_decrypt_finish, NULL, NULL);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, calc_hash,
-		    NULL, NULL, NULL);
+REGISTER_CRYPTO_LIB_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+			   verify_hash_start, verify_hash_update,
+			   verify_hash_finish, calc_hash, NULL, NULL, NULL,
+			   NULL, NULL, NULL);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY
 #if TF_MBEDTLS_USE_AES_AEAD
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    auth_decrypt, NULL, NULL);
+REGISTER_CRYPTO_LIB_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+			   verify_hash_start, verify_hash_update,
+			   verify_hash_finish, NULL, auth_decrypt,
+			   auth_decrypt_start, auth_decrypt_update,
+			   auth_decrypt_finish, NULL, NULL);
 #else
-REGISTER_CRYPTO_LIB(LIB_NAME, init, verify_signature, verify_hash, NULL,
-		    NULL, NULL, NULL);
+REGISTER_CRYPTO_LIB_STREAM(LIB_NAME, init, verify_signature, verify_hash,
+			   verify_hash_start, verify_hash_update,
+			   verify_hash_finish, NULL, NULL, NULL, NULL, NULL,
+			   NULL, NULL);
 #endif
 #elif CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY
 REGISTER_CRYPTO_LIB(LIB_NAME, init, NULL, NULL, calc_hash, NULL, NULL, NULL);
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/* mbed TLS headers */
+#include <mbedtls/build_info.h>
+
+#include <arch_features.h>
+
+/*
+ * With ENABLE_FEAT_CRYPTO=2 or ENABLE_FEAT_CRYPTO_SHA3=2, mbed TLS is built
+ * with its SHA-256 and SHA-512 code using the Cryptographic Extension when
+ * present, and asks getauxval() whether it is. Answer from ID_AA64ISAR0_EL1.
+ */
+unsigned long getauxval(unsigned long type)
+{
+	unsigned long hwcap = 0UL;
+
+	if (type != AT_HWCAP) {
+		return 0UL;
+	}
+
+#if defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT)
+	if (is_feat_sha256_supported()) {
+		hwcap |= HWCAP_SHA2;
+	}
+#endif
+#if defined(MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT)
+	if (is_feat_sha512_supported()) {
+		hwcap |= HWCAP_SHA512;
+	}
+#endif
+
+	return hwcap;
+}
@@ -11,6 +11,8 @@
 #include <common/tbbr/tbbr_img_def.h>
 #include <drivers/fwu/fwu.h>
 #include <drivers/fwu/fwu_metadata.h>
+#include <drivers/io/io_driver.h>
+#include <drivers/io/io_fip.h>
 #include <drivers/io/io_storage.h>
 
 #include <plat/common/platform.h>
@@ -314,4 +316,9 @@ void fwu_init(void)
 	is_metadata_initialized = true;
 
 	plat_fwu_set_images_source(&metadata);
+
+#if FIP_TOC_CACHE
+	/* The FIP may now be read from another bank */
+	fip_dev_invalidate_toc_cache();
+#endif
 }
@@ -7,6 +7,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <platform_def.h>
@@ -17,11 +18,31 @@
 #include <drivers/io/io_storage.h>
 #include <lib/utils.h>
 
+#if IO_BLOCK_CACHE
+typedef struct {
+	/* Device whose data the cache holds, NULL if the entry is free */
+	const io_block_dev_spec_t *dev_spec;
+	/* Number of block states of the device sharing the entry */
+	unsigned int		users;
+	/* Absolute device offset of each line */
+	unsigned long long	tag[IO_BLOCK_CACHE_MAX_LINES];
+	/* Number of valid bytes in each line, 0 if the line is free */
+	size_t			valid[IO_BLOCK_CACHE_MAX_LINES];
+	/* Last use of each line, used to find the least recently used one */
+	unsigned int		age[IO_BLOCK_CACHE_MAX_LINES];
+	unsigned int		clock;
+	io_block_cache_stats_t	stats;
+} block_cache_state_t;
+#endif /* IO_BLOCK_CACHE */
+
 typedef struct {
 	io_block_dev_spec_t	*dev_spec;
 	uintptr_t		base;
 	unsigned long long	file_pos;
 	unsigned long long	size;
+#if IO_BLOCK_CACHE
+	block_cache_state_t	*cache;
+#endif
 } block_dev_state_t;
 
 #define is_power_of_2(x)	(((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
@@ -59,6 +80,15 @@ static const io_dev_funcs_t block_dev_funcs = {
 static block_dev_state_t state_pool[MAX_IO_BLOCK_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_IO_BLOCK_DEVICES];
 
+#if IO_BLOCK_CACHE
+/*
+ * A device opened several times has a block state for each opening, but they
+ * all share the cache of the device, so that a write through any of them
+ * drops the lines that the others would otherwise read stale data from.
+ */
+static block_cache_state_t cache_pool[MAX_IO_BLOCK_DEVICES];
+#endif
+
 /* Track number of allocated block state */
 static unsigned int block_dev_count;
 
@@ -204,6 +234,185 @@ static int block_len(io_entity_t *entity, size_t *length)
 	return 0;
 }
 
+#if IO_BLOCK_CACHE
+static bool block_cache_enabled(const block_dev_state_t *cur)
+{
+	return cur->dev_spec->cache.line_count != 0U;
+}
+
+static void block_cache_invalidate(block_dev_state_t *cur)
+{
+	zeromem(cur->cache->valid, sizeof(cur->cache->valid));
+}
+
+/* Locate the cache of a device in the pool, NULL if it has none */
+static block_cache_state_t *find_block_cache(const io_block_dev_spec_t *dev_spec)
+{
+	unsigned int index;
+
+	for (index = 0U; index < MAX_IO_BLOCK_DEVICES; ++index) {
+		if ((cache_pool[index].users != 0U) &&
+		    (cache_pool[index].dev_spec == dev_spec)) {
+			return &cache_pool[index];
+		}
+	}
+
+	return NULL;
+}
+
+/* Share the cache of the device if it is already open, or else allocate one */
+static void block_cache_attach(block_dev_state_t *cur)
+{
+	block_cache_state_t *cache = find_block_cache(cur->dev_spec);
+	unsigned int index;
+
+	if (cache == NULL) {
+		for (index = 0U; index < MAX_IO_BLOCK_DEVICES; ++index) {
+			if (cache_pool[index].users == 0U) {
+				break;
+			}
+		}
+		/* There are as many caches as block states */
+		assert(index < MAX_IO_BLOCK_DEVICES);
+		cache = &cache_pool[index];
+		zeromem(cache, sizeof(block_cache_state_t));
+		cache->dev_spec = cur->dev_spec;
+	}
+
+	cache->users++;
+	cur->cache = cache;
+}
+
+static void block_cache_detach(block_dev_state_t *cur)
+{
+	assert(cur->cache->users != 0U);
+	cur->cache->users--;
+	cur->cache = NULL;
+}
+
+/*
+ * Find the cache line holding the byte at absolute device offset 'abs_pos',
+ * reading it from the device if needed. Reading a whole line rather than the
+ * requested bytes only is what allows subsequent small sequential reads (GPT
+ * entries, FIP table of contents, ...) to be served without device access.
+ */
+static int block_cache_get_line(block_dev_state_t *cur,
+				unsigned long long abs_pos,
+				unsigned int *line_out)
+{
+	const io_block_cache_spec_t *spec = &cur->dev_spec->cache;
+	block_cache_state_t *cache = cur->cache;
+	size_t block_size = cur->dev_spec->block_size;
+	unsigned long long line_pos, region_end;
+	size_t fill;
+	unsigned int line, victim = 0U;
+
+	line_pos = abs_pos - (abs_pos % spec->line_size);
+
+	for (line = 0U; line < spec->line_count; line++) {
+		if ((cache->valid[line] != 0U) &&
+		    (cache->tag[line] == line_pos) &&
+		    ((abs_pos - line_pos) < cache->valid[line])) {
+			cache->age[line] = ++cache->clock;
+			cache->stats.hits++;
+			*line_out = line;
+			return 0;
+		}
+
+		/* Pick a free line, or else the least recently used one */
+		if ((cache->valid[victim] != 0U) &&
+		    ((cache->valid[line] == 0U) ||
+		     (cache->age[line] < cache->age[victim]))) {
+			victim = line;
+		}
+	}
+
+	if ((line_pos / block_size) > (unsigned long long)INT_MAX) {
+		return -EINVAL;
+	}
+
+	/* Do not read beyond the end of the region */
+	region_end = cur->base + cur->size;
+	fill = spec->line_size;
+	if ((region_end - line_pos) < fill) {
+		fill = (size_t)(region_end - line_pos);
+		fill = (fill + (block_size - 1U)) & ~(block_size - 1U);
+	}
+
+	cache->stats.misses++;
+	cache->stats.dev_reads++;
+	fill = cur->dev_spec->ops.read((int)(line_pos / block_size),
+				       spec->base + (victim * spec->line_size),
+				       fill);
+	fill &= ~(block_size - 1U);
+	if (fill <= (abs_pos - line_pos)) {
+		cache->valid[victim] = 0U;
+		return -EIO;
+	}
+
+	cache->tag[victim] = line_pos;
+	cache->valid[victim] = fill;
+	cache->age[victim] = ++cache->clock;
+	*line_out = victim;
+
+	return 0;
+}
+
+/*
+ * Read 'length' bytes from the current position through the read cache.
+ */
+static int block_read_cached(block_dev_state_t *cur, uintptr_t buffer,
+			     size_t length)
+{
+	const io_block_cache_spec_t *spec = &cur->dev_spec->cache;
+	unsigned long long abs_pos;
+	size_t count = 0U, offset, nbytes;
+	unsigned int line;
+	int result;
+
+	while (count < length) {
+		if (add_overflow(cur->file_pos,
+				 (unsigned long long)cur->base, &abs_pos)) {
+			return -EINVAL;
+		}
+
+		result = block_cache_get_line(cur, abs_pos, &line);
+		if (result != 0) {
+			return result;
+		}
+
+		offset = (size_t)(abs_pos % spec->line_size);
+		nbytes = MIN(length - count, cur->cache->valid[line] - offset);
+
+		memcpy((void *)(buffer + count),
+		       (void *)(spec->base + (line * spec->line_size) + offset),
+		       nbytes);
+
+		cur->file_pos += nbytes;
+		count += nbytes;
+	}
+
+	return 0;
+}
+
+int io_block_get_cache_stats(const io_block_dev_spec_t *dev_spec,
+			     io_block_cache_stats_t *stats)
+{
+	const block_cache_state_t *cache;
+
+	assert((dev_spec != NULL) && (stats != NULL));
+
+	cache = find_block_cache(dev_spec);
+	if (cache == NULL) {
+		return -ENOENT;
+	}
+
+	*stats = cache->stats;
+
+	return 0;
+}
+#endif /* IO_BLOCK_CACHE */
+
 /*
  * This function allows the caller to read any number of bytes
  * from any position. It hides from the caller that the low level
@@ -273,6 +482,10 @@ static int block_len(io_entity_t *entity, size_t *length)
  *
  * Additionally, the IO driver has an underlying buffer that is at least
  * one block-size and may be big enough to allow.
+ *
+ * If the device has a read cache (IO_BLOCK_CACHE), reads that are smaller than
+ * a cache line go through the cache instead. Larger reads, typically image
+ * loads, bypass it so that they do not evict the metadata it holds.
  */
 static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		      size_t *length_read)
@@ -297,6 +510,9 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	 * to be read and the end of the block
 	 */
 	size_t padding;
+#if IO_BLOCK_CACHE
+	int result;
+#endif
 
 	assert(entity->info != (uintptr_t)NULL);
 	cur = (block_dev_state_t *)entity->info;
@@ -315,6 +531,17 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		return -EINVAL;
 	}
 
+#if IO_BLOCK_CACHE
+	if (block_cache_enabled(cur) &&
+	    (length < cur->dev_spec->cache.line_size)) {
+		result = block_read_cached(cur, buffer, length);
+		if (result == 0) {
+			*length_read = length;
+		}
+		return result;
+	}
+#endif
+
 	/*
 	 * We don't know the number of bytes that we are going
 	 * to read in every iteration, because it will depend
@@ -364,6 +591,9 @@ static int block_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 				~(block_size - 1U);
 		}
 		request = ops->read(lba, buf->offset, request);
+#if IO_BLOCK_CACHE
+		cur->cache->stats.dev_reads++;
+#endif
 
 		if (request <= skip) {
 			/*
@@ -443,6 +673,11 @@ static int block_write(io_entity_t *entity, const uintptr_t buffer,
 		return -EINVAL;
 	}
 
+#if IO_BLOCK_CACHE
+	/* Simply drop all the cached data rather than updating it */
+	block_cache_invalidate(cur);
+#endif
+
 	/*
 	 * We don't know the number of bytes that we are going
 	 * to write in every iteration, because it will depend
@@ -588,6 +823,19 @@ static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 		return -EINVAL;
 	}
 
+#if IO_BLOCK_CACHE
+	if ((cur->dev_spec->cache.line_count > IO_BLOCK_CACHE_MAX_LINES) ||
+	    ((cur->dev_spec->cache.line_count != 0U) &&
+	     ((cur->dev_spec->cache.line_size == 0U) ||
+	      ((cur->dev_spec->cache.base % block_size) != 0U) ||
+	      ((cur->dev_spec->cache.line_size % block_size) != 0U)))) {
+		(void)free_dev_info(info);
+		return -EINVAL;
+	}
+
+	block_cache_attach(cur);
+#endif
+
 	*dev_info = info;	/* cast away const */
 	(void)block_size;
 	(void)buffer;
@@ -596,6 +844,16 @@ static int block_dev_open(const uintptr_t dev_spec, io_dev_info_t **dev_info)
 
 static int block_dev_close(io_dev_info_t *dev_info)
 {
+#if IO_BLOCK_CACHE
+	block_dev_state_t *cur = (block_dev_state_t *)dev_info->info;
+
+	if (block_cache_enabled(cur)) {
+		VERBOSE("io_block: cache hits %u, misses %u, device reads %u\n",
+			cur->cache->stats.hits, cur->cache->stats.misses,
+			cur->cache->stats.dev_reads);
+	}
+	block_cache_detach(cur);
+#endif
 	return free_dev_info(dev_info);
 }
 
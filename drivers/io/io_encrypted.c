@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2020, Linaro Limited. All rights reserved.
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
  * Author: Sumit Garg <sumit.garg@linaro.org>
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -7,6 +8,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -18,16 +20,55 @@
 #include <drivers/io/io_driver.h>
 #include <drivers/io/io_encrypted.h>
 #include <drivers/io/io_storage.h>
+#include <lib/cassert.h>
 #include <lib/utils.h>
+#include <lib/utils_def.h>
 #include <plat/common/platform.h>
 #include <tools_share/firmware_encrypted.h>
 #include <tools_share/uuid.h>
 
+/*
+ * Size of the chunks in which the payload is read from the backend when the
+ * crypto library supports incremental decryption. Each chunk is decrypted
+ * right after it has been read, while it is still present in the data cache.
+ */
+#ifndef PLAT_ENC_READ_CHUNK_SIZE
+#define PLAT_ENC_READ_CHUNK_SIZE	U(0x4000)
+#endif
+
+/* All the chunks but the last one must be made of whole AES blocks */
+CASSERT((PLAT_ENC_READ_CHUNK_SIZE % 16U) == 0U,
+	assert_enc_read_chunk_size_not_aes_block_multiple);
+
+/*
+ * Maximum number of separate buffers the payload can be decrypted to before
+ * its authentication tag is checked. Reads to the same buffer, or to adjacent
+ * buffers, only use one of them.
+ */
+#define ENC_MAX_READ_RANGES	U(4)
+
 static uintptr_t backend_dev_handle;
 static uintptr_t backend_dev_spec;
 static uintptr_t backend_handle;
 static uintptr_t backend_image_spec;
 
+/*
+ * State of the payload decryption, which may span several reads of the
+ * encrypted file. The ranges of the caller buffers that hold decrypted data
+ * are recorded until the authentication tag has been checked, so that all of
+ * them can be wiped if the check fails.
+ */
+static struct {
+	bool started;
+	bool streaming;
+	size_t remaining;
+	unsigned int nr_ranges;
+	struct {
+		uintptr_t base;
+		uintptr_t end;
+	} ranges[ENC_MAX_READ_RANGES];
+} dec_state;
+
 static io_dev_info_t enc_dev_info;
 
 /* Encrypted firmware driver functions */
@@ -114,6 +155,7 @@ static int enc_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 	assert(entity != NULL);
 
 	backend_image_spec = spec;
+	zeromem(&dec_state, sizeof(dec_state));
 
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -150,20 +192,153 @@ static int enc_file_len(io_entity_t *entity, size_t *length)
 	return result;
 }
 
-static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
-			 size_t *length_read)
+/*
+ * Record that [base, base + length) is about to receive decrypted data. Returns
+ * false if it cannot be tracked along with the buffers of the previous reads.
+ */
+static bool enc_track_range(uintptr_t base, size_t length)
+{
+	uintptr_t end = base + length;
+	unsigned int i;
+
+	if (length == 0U) {
+		return true;
+	}
+
+	for (i = 0U; i < dec_state.nr_ranges; i++) {
+		if ((base <= dec_state.ranges[i].end) &&
+		    (end >= dec_state.ranges[i].base)) {
+			dec_state.ranges[i].base = MIN(base,
+						       dec_state.ranges[i].base);
+			dec_state.ranges[i].end = MAX(end,
+						      dec_state.ranges[i].end);
+			return true;
+		}
+	}
+
+	if (dec_state.nr_ranges == ENC_MAX_READ_RANGES) {
+		return false;
+	}
+
+	dec_state.ranges[dec_state.nr_ranges].base = base;
+	dec_state.ranges[dec_state.nr_ranges].end = end;
+	dec_state.nr_ranges++;
+
+	return true;
+}
+
+/* Wipe all the data decrypted since the start of the payload */
+static void enc_wipe_ranges(void)
+{
+	unsigned int i;
+
+	for (i = 0U; i < dec_state.nr_ranges; i++) {
+		memset((void *)dec_state.ranges[i].base, 0,
+		       dec_state.ranges[i].end - dec_state.ranges[i].base);
+	}
+
+	dec_state.nr_ranges = 0U;
+}
+
+/*
+ * Read the payload in chunks and decrypt each of them as soon as it has been
+ * read. The authentication tag is checked once the last byte of the payload
+ * has been decrypted. If that check, or the decryption of any chunk, fails,
+ * all the data decrypted from the payload is wiped, including that returned by
+ * the previous reads.
+ */
+static int enc_read_decrypt_stream(uintptr_t buffer, size_t length,
+				   size_t *length_read)
+{
+	int result;
+	size_t chunk_size, chunk_read;
+
+	length = MIN(length, dec_state.remaining);
+
+	if (!enc_track_range(buffer, length)) {
+		ERROR("Encrypted payload read to too many buffers\n");
+		return -ENOMEM;
+	}
+
+	while (*length_read < length) {
+		chunk_size = MIN(length - *length_read,
+				 (size_t)PLAT_ENC_READ_CHUNK_SIZE);
+		chunk_read = 0U;
+
+		result = io_read(backend_handle, buffer + *length_read,
+				 chunk_size, &chunk_read);
+		if (result != 0) {
+			WARN("Failed to read encrypted payload (%i)\n",
+			     result);
+			return -ENOENT;
+		}
+
+		if (chunk_read == 0U) {
+			break;
+		}
+
+		result = crypto_mod_auth_decrypt_update(
+				(void *)(buffer + *length_read), chunk_read);
+		if (result != 0) {
+			ERROR("File decryption failed (%i)\n", result);
+			dec_state.streaming = false;
+			enc_wipe_ranges();
+			return -ENOENT;
+		}
+
+		*length_read += chunk_read;
+		dec_state.remaining -= chunk_read;
+
+		/* Let the caller deal with the short read */
+		if (chunk_read < chunk_size) {
+			break;
+		}
+	}
+
+	if (dec_state.remaining == 0U) {
+		dec_state.streaming = false;
+
+		result = crypto_mod_auth_decrypt_finish();
+		if (result != 0) {
+			ERROR("File decryption failed (%i)\n", result);
+			enc_wipe_ranges();
+			return -ENOENT;
+		}
+
+		/* The decrypted data is authentic, it no longer needs wiping */
+		dec_state.nr_ranges = 0U;
+	}
+
+	return 0;
+}
+
+/*
+ * Read the encryption header and start decrypting the payload. If the crypto
+ * library supports it, the payload is decrypted as it is read, and may be read
+ * with several calls. Otherwise, it has to be read in full by this call before
+ * it can be decrypted.
+ */
+static int enc_read_start(uintptr_t buffer, size_t length, size_t *length_read)
 {
 	int result;
 	struct fw_enc_hdr header;
 	enum fw_enc_status_t fw_enc_status;
 	size_t bytes_read;
+	size_t payload_len;
 	uint8_t key[ENC_MAX_KEY_SIZE];
 	size_t key_len = sizeof(key);
 	unsigned int key_flags = 0;
 	const io_uuid_spec_t *uuid_spec = (io_uuid_spec_t *)backend_image_spec;
 
-	assert(entity != NULL);
-	assert(length_read != NULL);
+	dec_state.started = true;
+
+	result = io_size(backend_handle, &payload_len);
+	if ((result != 0) || (payload_len < sizeof(header))) {
+		WARN("Failed to read blob length (%i)\n", result);
+		return -ENOENT;
+	}
+
+	payload_len -= sizeof(header);
 
 	result = io_read(backend_handle, (uintptr_t)&header, sizeof(header),
 			 &bytes_read);
@@ -186,14 +361,6 @@ static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		return -ENOENT;
 	}
 
-	result = io_read(backend_handle, buffer, length, &bytes_read);
-	if (result != 0) {
-		WARN("Failed to read encrypted payload (%i)\n", result);
-		return -ENOENT;
-	}
-
-	*length_read = bytes_read;
-
 	result = plat_get_enc_key_info(fw_enc_status, key, &key_len, &key_flags,
 				       (uint8_t *)&uuid_spec->uuid,
 				       sizeof(uuid_t));
@@ -202,11 +369,37 @@ static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 		return -ENOENT;
 	}
 
-	result = crypto_mod_auth_decrypt(header.dec_algo,
-					 (void *)buffer, *length_read, key,
-					 key_len, key_flags, header.iv,
-					 header.iv_len, header.tag,
-					 header.tag_len);
+	result = crypto_mod_auth_decrypt_start(header.dec_algo, payload_len,
+					       key, key_len, key_flags,
+					       header.iv, header.iv_len,
+					       header.tag, header.tag_len);
+	if (result == CRYPTO_SUCCESS) {
+		memset(key, 0, key_len);
+		dec_state.streaming = true;
+		dec_state.remaining = payload_len;
+
+		return enc_read_decrypt_stream(buffer, length, length_read);
+	}
+
+	if (result == CRYPTO_ERR_UNKNOWN) {
+		/* Incremental decryption is not supported */
+		result = io_read(backend_handle, buffer, length, &bytes_read);
+		if (result != 0) {
+			WARN("Failed to read encrypted payload (%i)\n",
+			     result);
+			memset(key, 0, key_len);
+			return -ENOENT;
+		}
+
+		*length_read = bytes_read;
+
+		result = crypto_mod_auth_decrypt(header.dec_algo,
+						 (void *)buffer, *length_read,
+						 key, key_len, key_flags,
+						 header.iv, header.iv_len,
+						 header.tag, header.tag_len);
+	}
+
 	memset(key, 0, key_len);
 
 	if (result != 0) {
@@ -217,8 +410,44 @@ static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	return result;
 }
 
+static int enc_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
+			 size_t *length_read)
+{
+	assert(entity != NULL);
+	assert(length_read != NULL);
+
+	*length_read = 0U;
+
+	if (!dec_state.started) {
+		return enc_read_start(buffer, length, length_read);
+	}
+
+	if (!dec_state.streaming) {
+		if (dec_state.remaining == 0U) {
+			/* The whole payload has already been read */
+			return 0;
+		}
+
+		WARN("Encrypted payload cannot be read any further\n");
+		return -EIO;
+	}
+
+	return enc_read_decrypt_stream(buffer, length, length_read);
+}
+
 static int enc_file_close(io_entity_t *entity)
 {
+	if (dec_state.streaming) {
+		/*
+		 * Release the decryption context of an unfinished read. The
+		 * data decrypted so far has not been authenticated.
+		 */
+		(void)crypto_mod_auth_decrypt_finish();
+		dec_state.streaming = false;
+	}
+
+	enc_wipe_ranges();
+
 	io_close(backend_handle);
 
 	backend_image_spec = (uintptr_t)NULL;
@@ -7,7 +7,9 @@
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <platform_def.h>
@@ -26,6 +28,12 @@
 #define MAX_FIP_DEVICES		1
 #endif
 
+#if FIP_TOC_CACHE
+#ifndef FIP_TOC_CACHE_MAX_ENTRIES
+#define FIP_TOC_CACHE_MAX_ENTRIES	32U
+#endif
+#endif /* FIP_TOC_CACHE */
+
 /* Useful for printing UUIDs when debugging.*/
 #define PRINT_UUID2(x)								\
 	"%08x-%04hx-%04hx-%02hhx%02hhx-%02hhx%02hhx%02hhx%02hhx%02hhx%02hhx",	\
@@ -66,6 +74,28 @@ static uintptr_t backend_image_spec;
 static fip_dev_state_t state_pool[MAX_FIP_DEVICES];
 static io_dev_info_t dev_info_pool[MAX_FIP_DEVICES];
 
+#if FIP_TOC_CACHE
+/*
+ * Copy of the ToC of a FIP, sorted by UUID. It is built the first time the FIP
+ * device is initialised and is kept when the device is closed, so that opening
+ * a file does not require any backend access as long as the FIP is read from
+ * the same backend. The cache is 'complete' if the whole ToC fits in it, in
+ * which case a UUID that is not found is known not to be in the FIP.
+ */
+typedef struct {
+	bool valid;
+	bool complete;
+	uintptr_t dev_handle;
+	uintptr_t image_spec;
+	size_t fip_size;
+	uint16_t plat_toc_flag;
+	unsigned int num_entries;
+	fip_toc_entry_t entries[FIP_TOC_CACHE_MAX_ENTRIES];
+} fip_toc_cache_t;
+
+static fip_toc_cache_t toc_cache_pool[MAX_FIP_DEVICES];
+#endif /* FIP_TOC_CACHE */
+
 /* Track number of allocated fip devices */
 static unsigned int fip_dev_count;
 
@@ -76,6 +106,7 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 static int fip_file_len(io_entity_t *entity, size_t *length);
 static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			  size_t *length_read);
+static int fip_file_map(io_entity_t *entity, size_t length, uintptr_t *addr);
 static int fip_file_close(io_entity_t *entity);
 static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params);
 static int fip_dev_close(io_dev_info_t *dev_info);
@@ -98,6 +129,109 @@ static inline int is_valid_header(fip_toc_header_t *header)
 }
 
 
+#if FIP_TOC_CACHE
+static int compare_toc_entries(const void *entry1, const void *entry2)
+{
+	return compare_uuids(&((const fip_toc_entry_t *)entry1)->uuid,
+			     &((const fip_toc_entry_t *)entry2)->uuid);
+}
+
+/* Return the ToC cache of a FIP device */
+static fip_toc_cache_t *get_toc_cache(const fip_dev_state_t *state)
+{
+	return &toc_cache_pool[state - state_pool];
+}
+
+/* Check whether the ToC cache holds the ToC of the current backend */
+static bool is_toc_cache_valid(const fip_toc_cache_t *cache)
+{
+	return cache->valid && (cache->dev_handle == backend_dev_handle) &&
+	       (cache->image_spec == backend_image_spec);
+}
+
+/*
+ * Read the ToC entries following the FIP header from the backend into the
+ * cache. Failing to do so is not fatal, files are then looked up in the FIP
+ * itself.
+ */
+static void fill_toc_cache(fip_toc_cache_t *cache, uintptr_t backend_handle,
+			   const fip_dev_state_t *state)
+{
+	static const uuid_t uuid_null = { 0U };
+	fip_toc_entry_t entry;
+	size_t toc_offset = sizeof(fip_toc_header_t);
+	size_t bytes_read;
+	int result;
+
+	zeromem(cache, sizeof(fip_toc_cache_t));
+
+	while (toc_offset <= (state->fip_size - sizeof(entry))) {
+		result = io_read(backend_handle, (uintptr_t)&entry,
+				 sizeof(entry), &bytes_read);
+		if ((result != 0) || (bytes_read != sizeof(entry))) {
+			return;
+		}
+
+		if (compare_uuids(&entry.uuid, &uuid_null) == 0) {
+			cache->complete = true;
+			break;
+		}
+
+		if (cache->num_entries == FIP_TOC_CACHE_MAX_ENTRIES) {
+			break;
+		}
+
+		cache->entries[cache->num_entries++] = entry;
+		toc_offset += sizeof(entry);
+	}
+
+	qsort(cache->entries, cache->num_entries, sizeof(fip_toc_entry_t),
+	      compare_toc_entries);
+
+	cache->dev_handle = backend_dev_handle;
+	cache->image_spec = backend_image_spec;
+	cache->fip_size = state->fip_size;
+	cache->plat_toc_flag = state->plat_toc_flag;
+	cache->valid = true;
+
+	VERBOSE("FIP ToC cached (%u entries%s)\n", cache->num_entries,
+		cache->complete ? "" : ", partial");
+}
+
+/*
+ * Look up a UUID in the ToC cache using a binary search.
+ *
+ * Returns 0 if the entry is found, -ENOENT if it is known not to be in the FIP
+ * and -EAGAIN if the FIP itself must be searched.
+ */
+static int find_toc_cache_entry(const fip_toc_cache_t *cache,
+				const uuid_t *uuid, fip_toc_entry_t *entry)
+{
+	unsigned int low = 0U, high, mid;
+	int cmp;
+
+	if (!is_toc_cache_valid(cache)) {
+		return -EAGAIN;
+	}
+
+	high = cache->num_entries;
+	while (low < high) {
+		mid = low + ((high - low) / 2U);
+		cmp = compare_uuids(&cache->entries[mid].uuid, uuid);
+		if (cmp == 0) {
+			*entry = cache->entries[mid];
+			return 0;
+		} else if (cmp < 0) {
+			low = mid + 1U;
+		} else {
+			high = mid;
+		}
+	}
+
+	return cache->complete ? -ENOENT : -EAGAIN;
+}
+#endif /* FIP_TOC_CACHE */
+
 /* Identify the device type as a virtual driver */
 static io_type_t device_type_fip(void)
 {
@@ -117,6 +251,7 @@ static const io_dev_funcs_t fip_dev_funcs = {
 	.size = fip_file_len,
 	.read = fip_file_read,
 	.write = NULL,
+	.map = fip_file_map,
 	.close = fip_file_close,
 	.dev_init = fip_dev_init,
 	.dev_close = fip_dev_close,
@@ -239,6 +374,15 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 		goto fip_dev_init_exit;
 	}
 
+#if FIP_TOC_CACHE
+	/* The FIP has already been checked if its ToC is in the cache */
+	if (is_toc_cache_valid(get_toc_cache(state))) {
+		state->fip_size = get_toc_cache(state)->fip_size;
+		state->plat_toc_flag = get_toc_cache(state)->plat_toc_flag;
+		goto fip_dev_init_exit;
+	}
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -279,6 +423,10 @@ static int fip_dev_init(io_dev_info_t *dev_info, const uintptr_t init_params)
 			 * bits [32-47] in fip header.
 			 */
 			state->plat_toc_flag = (header.flags >> 32) & 0xffff;
+#if FIP_TOC_CACHE
+			fill_toc_cache(get_toc_cache(state), backend_handle,
+				       state);
+#endif
 		}
 	}
 
@@ -302,6 +450,43 @@ static int fip_dev_close(io_dev_info_t *dev_info)
 }
 
 
+/*
+ * Check that the ToC entry found for a file lies within the FIP and make it
+ * the current file.
+ */
+static int set_current_file(io_entity_t *entity, size_t fip_size)
+{
+	uint64_t offset;
+	uint64_t size;
+	uint64_t fip_size64;
+
+	offset = current_fip_file.entry.offset_address;
+	size = current_fip_file.entry.size;
+	fip_size64 = (uint64_t)fip_size;
+
+	if ((size == 0U) ||
+	    (offset >= fip_size64) ||
+	    (size > fip_size64) ||
+	    (offset + size < offset) ||
+	    (offset + size > fip_size64) ||
+	    (offset > (uint64_t)SIZE_MAX) ||
+	    (size > (uint64_t)SIZE_MAX) ||
+	    (offset + size > (uint64_t)SIZE_MAX)) {
+		ERROR("FIP entry bounds invalid\n");
+		return -EINVAL;
+	}
+
+	/* All fine. Update entity info with file state and return. Set
+	 * the file position to 0. The 'current_fip_file.entry' holds
+	 * the base and size of the file.
+	 */
+	current_fip_file.file_pos = 0;
+	current_fip_file.fip_size = fip_size;
+	entity->info = (uintptr_t)&current_fip_file;
+
+	return 0;
+}
+
 /* Open a file for access from package. */
 static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 			 io_entity_t *entity)
@@ -342,6 +527,17 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 		return -ENFILE;
 	}
 
+#if FIP_TOC_CACHE
+	result = find_toc_cache_entry(get_toc_cache(state), &uuid_spec->uuid,
+				      &current_fip_file.entry);
+	if (result != -EAGAIN) {
+		if (result == 0) {
+			result = set_current_file(entity, fip_size);
+		}
+		goto fip_file_open_exit;
+	}
+#endif
+
 	/* Attempt to access the FIP image */
 	result = io_open(backend_dev_handle, backend_image_spec,
 			 &backend_handle);
@@ -394,34 +590,7 @@ static int fip_file_open(io_dev_info_t *dev_info, const uintptr_t spec,
 				&uuid_null) != 0));
 
 	if (found_file == 1) {
-		uint64_t offset;
-		uint64_t size;
-		uint64_t fip_size64;
-
-		offset = current_fip_file.entry.offset_address;
-		size = current_fip_file.entry.size;
-		fip_size64 = (uint64_t)fip_size;
-
-		if ((size == 0U) ||
-		    (offset >= fip_size64) ||
-		    (size > fip_size64) ||
-		    (offset + size < offset) ||
-		    (offset + size > fip_size64) ||
-		    (offset > (uint64_t)SIZE_MAX) ||
-		    (size > (uint64_t)SIZE_MAX) ||
-		    (offset + size > (uint64_t)SIZE_MAX)) {
-			ERROR("FIP entry bounds invalid\n");
-			result = -EINVAL;
-			goto fip_file_open_close;
-		}
-
-		/* All fine. Update entity info with file state and return. Set
-		 * the file position to 0. The 'current_fip_file.entry' holds
-		 * the base and size of the file.
-		 */
-		current_fip_file.file_pos = 0;
-		current_fip_file.fip_size = fip_size;
-		entity->info = (uintptr_t)&current_fip_file;
+		result = set_current_file(entity, fip_size);
 	} else {
 		/* Did not find the file in the FIP. */
 		current_fip_file.entry.offset_address = 0;
@@ -451,44 +620,27 @@ static int fip_file_len(io_entity_t *entity, size_t *length)
 }
 
 
-/* Read data from a file in package */
-static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
-			  size_t *length_read)
+/*
+ * Check that 'length' bytes can be accessed from the current position of a file
+ * in package and seek the backend to the position in the FIP where they live.
+ */
+static int seek_payload(const fip_file_state_t *fp, uintptr_t backend_handle,
+			size_t length)
 {
 	int result;
-	fip_file_state_t *fp;
-	size_t bytes_read;
-	uintptr_t backend_handle;
 	size_t remaining;
 	uint64_t fip_size64;
 	uint64_t file_offset64;
 
-	assert(entity != NULL);
-	assert(length_read != NULL);
-	assert(entity->info != (uintptr_t)NULL);
-
-	/* Open the backend, attempt to access the blob image */
-	result = io_open(backend_dev_handle, backend_image_spec,
-			 &backend_handle);
-	if (result != 0) {
-		WARN("Failed to open FIP (%i)\n", result);
-		result = -ENOENT;
-		goto fip_file_read_exit;
-	}
-
-	fp = (fip_file_state_t *)entity->info;
-
 	if (fp->file_pos > fp->entry.size) {
 		ERROR("FIP read: file position out of bounds\n");
-		result = -EINVAL;
-		goto fip_file_read_close;
+		return -EINVAL;
 	}
 
 	remaining = (size_t)(fp->entry.size - fp->file_pos);
 	if (length > remaining) {
 		ERROR("FIP read: length out of bounds\n");
-		result = -EINVAL;
-		goto fip_file_read_close;
+		return -EINVAL;
 	}
 
 	fip_size64 = (uint64_t)fp->fip_size;
@@ -498,8 +650,7 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 	    (file_offset64 + length > fip_size64) ||
 	    (file_offset64 > (uint64_t)LLONG_MAX)) {
 		ERROR("FIP read: offset out of bounds\n");
-		result = -EINVAL;
-		goto fip_file_read_close;
+		return -EINVAL;
 	}
 
 	/* Seek to the position in the FIP where the payload lives */
@@ -507,7 +658,39 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 			 (signed long long)file_offset64);
 	if (result != 0) {
 		WARN("fip_file_read: failed to seek\n");
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+
+/* Read data from a file in package */
+static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
+			  size_t *length_read)
+{
+	int result;
+	fip_file_state_t *fp;
+	size_t bytes_read;
+	uintptr_t backend_handle;
+
+	assert(entity != NULL);
+	assert(length_read != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	/* Open the backend, attempt to access the blob image */
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		WARN("Failed to open FIP (%i)\n", result);
 		result = -ENOENT;
+		goto fip_file_read_exit;
+	}
+
+	fp = (fip_file_state_t *)entity->info;
+
+	result = seek_payload(fp, backend_handle, length);
+	if (result != 0) {
 		goto fip_file_read_close;
 	}
 
@@ -536,6 +719,45 @@ static int fip_file_read(io_entity_t *entity, uintptr_t buffer, size_t length,
 }
 
 
+/*
+ * Return the address of data in a file in package. This is only possible if the
+ * backend holding the FIP is memory-mapped, -ENODEV is returned otherwise. The
+ * address remains valid after the backend has been closed.
+ */
+static int fip_file_map(io_entity_t *entity, size_t length, uintptr_t *addr)
+{
+	int result;
+	fip_file_state_t *fp;
+	uintptr_t backend_handle;
+
+	assert(entity != NULL);
+	assert(addr != NULL);
+	assert(entity->info != (uintptr_t)NULL);
+
+	/* Open the backend, attempt to access the blob image */
+	result = io_open(backend_dev_handle, backend_image_spec,
+			 &backend_handle);
+	if (result != 0) {
+		WARN("Failed to open FIP (%i)\n", result);
+		return -ENOENT;
+	}
+
+	fp = (fip_file_state_t *)entity->info;
+
+	result = seek_payload(fp, backend_handle, length);
+	if (result == 0) {
+		result = io_map(backend_handle, length, addr);
+		if (result == 0) {
+			fp->file_pos += length;
+		}
+	}
+
+	io_close(backend_handle);
+
+	return result;
+}
+
+
 /* Close a file in package */
 static int fip_file_close(io_entity_t *entity)
 {
@@ -554,6 +776,20 @@ static int fip_file_close(io_entity_t *entity)
 
 /* Exported functions */
 
+#if FIP_TOC_CACHE
+/*
+ * Drop the cached ToC of all FIP devices. This must be called whenever the
+ * content of a FIP may have changed without its backend changing, e.g. after
+ * a firmware update or when the platform switches to another instance of an
+ * image by updating the backend image spec in place, so that the ToC is read
+ * and checked again on the next access.
+ */
+void fip_dev_invalidate_toc_cache(void)
+{
+	zeromem(toc_cache_pool, sizeof(toc_cache_pool));
+}
+#endif /* FIP_TOC_CACHE */
+
 /* Register the Firmware Image Package driver with the IO abstraction */
 int register_io_dev_fip(const io_dev_connector_t **dev_con)
 {
@@ -48,6 +48,8 @@ static int memmap_block_read(io_entity_t *entity, uintptr_t buffer,
 			     size_t length, size_t *length_read);
 static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 			      size_t length, size_t *length_written);
+static int memmap_block_map(io_entity_t *entity, size_t length,
+			    uintptr_t *addr);
 static int memmap_block_close(io_entity_t *entity);
 static int memmap_dev_close(io_dev_info_t *dev_info);
 
@@ -64,6 +66,7 @@ static const io_dev_funcs_t memmap_dev_funcs = {
 	.size = memmap_block_len,
 	.read = memmap_block_read,
 	.write = memmap_block_write,
+	.map = memmap_block_map,
 	.close = memmap_block_close,
 	.dev_init = NULL,
 	.dev_close = memmap_dev_close,
@@ -230,6 +233,33 @@ static int memmap_block_write(io_entity_t *entity, const uintptr_t buffer,
 }
 
 
+/* Return the address of data in a file on the memmap device */
+static int memmap_block_map(io_entity_t *entity, size_t length,
+			    uintptr_t *addr)
+{
+	memmap_file_state_t *fp;
+	unsigned long long pos_after;
+
+	assert(entity != NULL);
+	assert(addr != NULL);
+
+	fp = (memmap_file_state_t *) entity->info;
+
+	/* Assert that file position is valid for this map operation */
+	pos_after = fp->file_pos + length;
+	if ((pos_after < fp->file_pos) || (pos_after > fp->size)) {
+		return -EINVAL;
+	}
+
+	*addr = (uintptr_t)(fp->base + fp->file_pos);
+
+	/* Set file position after the mapped data, as a read would do */
+	fp->file_pos = pos_after;
+
+	return 0;
+}
+
+
 /* Close a file on the memmap device */
 static int memmap_block_close(io_entity_t *entity)
 {
@@ -1,10 +1,11 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <platform_def.h>
@@ -328,6 +329,27 @@ int io_erase(uintptr_t handle, size_t length)
 }
 
 
+/*
+ * Get the address of a region of an IO entity on memory-mapped storage
+ */
+int io_map(uintptr_t handle, size_t length, uintptr_t *addr)
+{
+	int result = -ENODEV;
+
+	assert(is_valid_entity(handle) && (addr != NULL));
+
+	io_entity_t *entity = (io_entity_t *)handle;
+
+	io_dev_info_t *dev = entity->dev_handle;
+
+	if (dev->funcs->map != NULL) {
+		result = dev->funcs->map(entity, length, addr);
+	}
+
+	return result;
+}
+
+
 /* Close an IO entity */
 int io_close(uintptr_t handle)
 {
@@ -104,6 +104,10 @@
 	gen(feat_sha1, id_aa64isar0_el1, ENABLE_FEAT_CRYPTO,			\
 	    ID_AA64ISAR0_SHA1, 1U, 1U, FEAT_ENABLE_ALL_WORLDS)
 
+#define FEAT_SHA256(gen)							\
+	gen(feat_sha256, id_aa64isar0_el1, ENABLE_FEAT_CRYPTO,			\
+	    ID_AA64ISAR0_SHA2, 1U, 2U, FEAT_ENABLE_ALL_WORLDS)
+
 /* Not named in the architecture. Relates to FEAT_TRC_SR */
 #define FEAT_SYS_REG_TRACE(gen)							\
 	gen(feat_sys_reg_trace, id_aa64dfr0_el1, ENABLE_SYS_REG_TRACE_FOR_NS,	\
@@ -123,6 +127,10 @@
 	    ID_AA64MMFR1_EL1_VHE, 1U, 1U, FEAT_ENABLE_ALL_WORLDS)
 
 /* === v8.2 features === */
+#define FEAT_SHA512(gen)							\
+	gen(feat_sha512, id_aa64isar0_el1, ENABLE_FEAT_CRYPTO_SHA3,		\
+	    ID_AA64ISAR0_SHA2, 2U, 2U, FEAT_ENABLE_ALL_WORLDS)
+
 #define FEAT_RAS(gen)								\
 	gen(feat_ras, id_aa64pfr0_el1, ENABLE_FEAT_RAS,				\
 	    ID_AA64PFR0_RAS, 1U, 3U, FEAT_ENABLE_ALL_WORLDS)
@@ -626,6 +634,14 @@ FEAT_AMU_AUX(CREATE_FEATURE_FUNCS)
 CTX_PAUTH(CREATE_FEATURE_SUPPORTED)
 FEAT_MPAM_PE_BW_CTRL(CREATE_FEATURE_FUNCS)
 
+/*
+ * Only used to pick the SHA-2 implementation at runtime. Both are described by
+ * the SHA2 field of ID_AA64ISAR0_EL1, which FEAT_IDTE3 would otherwise hide
+ * from lower ELs whenever FEAT_SHA512 alone is disabled.
+ */
+FEAT_SHA256(CREATE_FEATURE_FUNCS)
+FEAT_SHA512(CREATE_FEATURE_FUNCS)
+
 /*******************************************************************************
  * Non-standard, not directly architectural helpers
  ******************************************************************************/
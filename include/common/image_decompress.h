@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -16,9 +16,30 @@ typedef int (decompressor_t)(uintptr_t *in_buf, size_t in_len,
 			     uintptr_t *out_buf, size_t out_len,
 			     uintptr_t work_buf, size_t work_len);
 
+/*
+ * Decompressor fed with the compressed data in chunks. start() is given the
+ * destination and the workspace, update() each chunk of compressed data in
+ * order, and finish() returns the end of the decompressed data.
+ */
+typedef struct decompressor_stream {
+	int (*start)(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		     size_t work_len);
+	int (*update)(uintptr_t in_buf, size_t in_len);
+	int (*finish)(uintptr_t *out_buf);
+} decompressor_stream_t;
+
 void image_decompress_init(uintptr_t buf_base, uint32_t buf_size,
 			   decompressor_t *decompressor);
 void image_decompress_prepare(struct image_info *info);
 int image_decompress(struct image_info *info);
 
+#if IMAGE_DECOMPRESS_STREAMING
+void image_decompress_stream_init(uintptr_t buf_base, uint32_t buf_size,
+				  const decompressor_stream_t *ops);
+int image_decompress_stream_start(const struct image_info *info,
+				  uintptr_t *chunk_base, size_t *chunk_size);
+int image_decompress_stream_update(size_t len);
+int image_decompress_stream_finish(struct image_info *info);
+#endif /* IMAGE_DECOMPRESS_STREAMING */
+
 #endif /* IMAGE_DECOMPRESS_H */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef TF_LOG_DEFERRED_H
+#define TF_LOG_DEFERRED_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lib/cassert.h>
+#include <lib/utils_def.h>
+#include <platform_def.h>
+
+/*
+ * Size in bytes of the log ring of each CPU. Must be a power of two.
+ */
+#ifndef PLAT_LOG_DEFERRED_RING_SIZE
+#define PLAT_LOG_DEFERRED_RING_SIZE	U(2048)
+#endif
+
+/* Longest message, prefix included, stored by a single log call */
+#define TF_LOG_DEFERRED_MSG_MAX		U(128)
+
+CASSERT(IS_POWER_OF_TWO(PLAT_LOG_DEFERRED_RING_SIZE),
+	assert_log_deferred_ring_size_pow2);
+CASSERT(PLAT_LOG_DEFERRED_RING_SIZE >= TF_LOG_DEFERRED_MSG_MAX,
+	assert_log_deferred_ring_size_min);
+
+/*
+ * Log ring of a CPU. Only the owning CPU writes to it. The indices count the
+ * bytes ever written, the byte with index 'i' lives in buf[i % size].
+ *
+ * The writer first advances 'reserve_idx' past the message it is about to
+ * write, then copies the message and finally advances 'commit_idx'. A reader
+ * copies the bytes below 'commit_idx' and then discards those which fell below
+ * 'reserve_idx - size' in the meantime, as they may have been overwritten.
+ */
+typedef struct tf_log_ring {
+	volatile uint64_t reserve_idx;
+	volatile uint64_t commit_idx;
+	char buf[PLAT_LOG_DEFERRED_RING_SIZE];
+} tf_log_ring_t;
+
+#if ENABLE_DEFERRED_LOG && defined(IMAGE_BL31)
+void tf_log_deferred_start(void);
+void tf_log_deferred_flush(void);
+void tf_log_deferred_flush_local(void);
+bool tf_log_deferred_vprintf(const char *prefix, const char *fmt,
+			     va_list args);
+bool tf_log_deferred_newline(void);
+#else
+static inline void tf_log_deferred_start(void)
+{
+}
+
+static inline void tf_log_deferred_flush(void)
+{
+}
+
+static inline void tf_log_deferred_flush_local(void)
+{
+}
+#endif /* ENABLE_DEFERRED_LOG && IMAGE_BL31 */
+
+#endif /* TF_LOG_DEFERRED_H */
@@ -7,6 +7,8 @@
 #ifndef AUTH_MOD_H
 #define AUTH_MOD_H
 
+#include <stddef.h>
+
 #include <common/tbbr/tbbr_img_def.h>
 #include <drivers/auth/auth_common.h>
 #include <drivers/auth/img_parser_mod.h>
@@ -55,6 +57,19 @@ int auth_mod_verify_img(unsigned int img_id,
 			void *img_ptr,
 			unsigned int img_len);
 
+#if IMAGE_HASH_STREAMING
+int auth_mod_hash_stream_start(unsigned int img_id);
+void auth_mod_hash_stream_update(void *data_ptr, unsigned int data_len);
+void auth_mod_hash_stream_consume(void *data_ptr, unsigned int data_len);
+void auth_mod_hash_stream_bind(void *data_ptr, unsigned int data_len);
+void auth_mod_hash_stream_abort(void);
+#endif /* IMAGE_HASH_STREAMING */
+
+#if AUTH_CERT_HANDOFF
+size_t auth_mod_export_verified(void *buf, size_t size);
+int auth_mod_import_verified(const void *buf, size_t len);
+#endif /* AUTH_CERT_HANDOFF */
+
 /* Macro to register a CoT defined as an array of auth_img_desc_t pointers */
 #define REGISTER_COT(_cot) \
 	const auth_img_desc_t *const *const cot_desc_ptr = (_cot); \
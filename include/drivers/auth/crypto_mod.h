@@ -65,6 +65,18 @@ typedef struct crypto_lib_desc_s {
 	int (*verify_hash)(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
 
+	/*
+	 * Incremental hash verification (optional). The digest to match is
+	 * provided when the operation is started, the data is then fed in
+	 * chunks and the comparison is done when the operation is finished.
+	 * Only one operation can be in progress at a time. Return one of the
+	 * 'enum crypto_ret_value' options.
+	 */
+	int (*verify_hash_start)(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+	int (*verify_hash_update)(void *data_ptr, unsigned int data_len);
+	int (*verify_hash_finish)(void);
+
 	/* Calculate a hash. Return hash value */
 	int (*calc_hash)(enum crypto_md_algo md_alg, void *data_ptr,
 			 unsigned int data_len,
@@ -84,6 +96,22 @@ typedef struct crypto_lib_desc_s {
 			    unsigned int iv_len, const void *tag,
 			    unsigned int tag_len);
 
+	/*
+	 * Incremental authenticated decryption (optional). The total length of
+	 * the data and the tag to match are provided when the operation is
+	 * started, the data is then decrypted in place in chunks and the tag
+	 * is checked when the operation is finished. Only one operation can be
+	 * in progress at a time. Return one of the 'enum crypto_ret_value'
+	 * options.
+	 */
+	int (*auth_decrypt_start)(enum crypto_dec_algo dec_algo, size_t len,
+				  const void *key, unsigned int key_len,
+				  unsigned int key_flags, const void *iv,
+				  unsigned int iv_len, const void *tag,
+				  unsigned int tag_len);
+	int (*auth_decrypt_update)(void *data_ptr, size_t len);
+	int (*auth_decrypt_finish)(void);
+
 	/*
 	 * Finish using the crypto library,
 	 * anything to be done to wrap up crypto usage done here.
@@ -108,6 +136,10 @@ int crypto_mod_verify_signature(void *data_ptr, unsigned int data_len,
 				void *pk_ptr, unsigned int pk_len);
 int crypto_mod_verify_hash(void *data_ptr, unsigned int data_len,
 			   void *digest_info_ptr, unsigned int digest_info_len);
+int crypto_mod_verify_hash_start(void *digest_info_ptr,
+				 unsigned int digest_info_len);
+int crypto_mod_verify_hash_update(void *data_ptr, unsigned int data_len);
+int crypto_mod_verify_hash_finish(void);
 #endif /* (CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_ONLY) || \
 	  (CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC) */
 
@@ -116,6 +148,13 @@ int crypto_mod_auth_decrypt(enum crypto_dec_algo dec_algo, void *data_ptr,
 			    unsigned int key_flags, const void *iv,
 			    unsigned int iv_len, const void *tag,
 			    unsigned int tag_len);
+int crypto_mod_auth_decrypt_start(enum crypto_dec_algo dec_algo, size_t len,
+				  const void *key, unsigned int key_len,
+				  unsigned int key_flags, const void *iv,
+				  unsigned int iv_len, const void *tag,
+				  unsigned int tag_len);
+int crypto_mod_auth_decrypt_update(void *data_ptr, size_t len);
+int crypto_mod_auth_decrypt_finish(void);
 
 #if (CRYPTO_SUPPORT == CRYPTO_HASH_CALC_ONLY) || \
     (CRYPTO_SUPPORT == CRYPTO_AUTH_VERIFY_AND_HASH_CALC)
@@ -141,13 +180,35 @@ static inline void crypto_mod_finish(void)
 /* Macro to register a cryptographic library */
 #define REGISTER_CRYPTO_LIB(_name, _init, _verify_signature, _verify_hash, \
 			    _calc_hash, _auth_decrypt, _convert_pk, _finish) \
+	REGISTER_CRYPTO_LIB_STREAM(_name, _init, _verify_signature, \
+				   _verify_hash, NULL, NULL, NULL, \
+				   _calc_hash, _auth_decrypt, NULL, NULL, NULL, \
+				   _convert_pk, _finish)
+
+/*
+ * Macro to register a cryptographic library that also supports incremental
+ * hash verification and authenticated decryption
+ */
+#define REGISTER_CRYPTO_LIB_STREAM(_name, _init, _verify_signature, \
+				   _verify_hash, _verify_hash_start, \
+				   _verify_hash_update, _verify_hash_finish, \
+				   _calc_hash, _auth_decrypt, \
+				   _auth_decrypt_start, _auth_decrypt_update, \
+				   _auth_decrypt_finish, _convert_pk, \
+				   _finish) \
 	const crypto_lib_desc_t crypto_lib_desc = { \
 		.name = _name, \
 		.init = _init, \
 		.verify_signature = _verify_signature, \
 		.verify_hash = _verify_hash, \
+		.verify_hash_start = _verify_hash_start, \
+		.verify_hash_update = _verify_hash_update, \
+		.verify_hash_finish = _verify_hash_finish, \
 		.calc_hash = _calc_hash, \
 		.auth_decrypt = _auth_decrypt, \
+		.auth_decrypt_start = _auth_decrypt_start, \
+		.auth_decrypt_update = _auth_decrypt_update, \
+		.auth_decrypt_finish = _auth_decrypt_finish, \
 		.convert_pk = _convert_pk, \
 		.finish = _finish \
 	}
@@ -83,6 +83,8 @@
 	#define MBEDTLS_SHA256_C
 	#if (ENABLE_FEAT_CRYPTO == 1)
 		#define MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_ONLY
+	#elif (ENABLE_FEAT_CRYPTO == 2) && defined(__aarch64__)
+		#define MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT
 	#endif
 #endif
 
@@ -91,6 +93,9 @@
 	#if (ENABLE_FEAT_CRYPTO_SHA3 == 1)
 		#define MBEDTLS_SHA512_C
 		#define MBEDTLS_SHA512_USE_A64_CRYPTO_ONLY
+	#elif (ENABLE_FEAT_CRYPTO_SHA3 == 2) && defined(__aarch64__)
+		#define MBEDTLS_SHA512_C
+		#define MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT
 	#endif
 #endif
 
@@ -98,9 +103,24 @@
 	#define MBEDTLS_SHA512_C
 	#if (ENABLE_FEAT_CRYPTO_SHA3 == 1)
 		#define MBEDTLS_SHA512_USE_A64_CRYPTO_ONLY
+	#elif (ENABLE_FEAT_CRYPTO_SHA3 == 2) && defined(__aarch64__)
+		#define MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT
 	#endif
 #endif
 
+/*
+ * mbed TLS checks for the SHA-2 instructions at runtime with getauxval() when
+ * the Linux HWCAP bits are defined. mbedtls_sha2.c provides it.
+ */
+#if defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT) || \
+	defined(MBEDTLS_SHA512_USE_A64_CRYPTO_IF_PRESENT)
+	#define AT_HWCAP	16UL
+	#define HWCAP_SHA2	(1UL << 6)
+	#define HWCAP_SHA512	(1UL << 21)
+
+	unsigned long getauxval(unsigned long type);
+#endif
+
 #define MBEDTLS_VERSION_C
 
 #define MBEDTLS_X509_USE_C
@@ -159,13 +179,25 @@
  * Determine Mbed TLS heap size.
  */
 #if TF_MBEDTLS_USE_ECDSA
-#define TF_MBEDTLS_HEAP_SIZE		U(13 * 1024)
+#define TF_MBEDTLS_BASE_HEAP_SIZE	U(13 * 1024)
+#define TF_MBEDTLS_PK_CACHE_HEAP_SIZE	U(2 * 1024)
 #elif TF_MBEDTLS_USE_RSA
 #if TF_MBEDTLS_KEY_SIZE <= 2048
-#define TF_MBEDTLS_HEAP_SIZE		U(7 * 1024)
+#define TF_MBEDTLS_BASE_HEAP_SIZE	U(7 * 1024)
+#define TF_MBEDTLS_PK_CACHE_HEAP_SIZE	U(1 * 1024)
 #else
-#define TF_MBEDTLS_HEAP_SIZE		U(11 * 1024)
+#define TF_MBEDTLS_BASE_HEAP_SIZE	U(11 * 1024)
+#define TF_MBEDTLS_PK_CACHE_HEAP_SIZE	U(2 * 1024)
+#endif
 #endif
+
+/* Each public key context kept parsed takes some more heap */
+#if TF_MBEDTLS_PK_CACHE_ENTRIES
+#define TF_MBEDTLS_HEAP_SIZE		(TF_MBEDTLS_BASE_HEAP_SIZE + \
+					 (TF_MBEDTLS_PK_CACHE_ENTRIES * \
+					  TF_MBEDTLS_PK_CACHE_HEAP_SIZE))
+#else
+#define TF_MBEDTLS_HEAP_SIZE		TF_MBEDTLS_BASE_HEAP_SIZE
 #endif
 
 /*
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,14 +15,50 @@ typedef struct io_block_ops {
 	size_t	(*write)(int lba, const uintptr_t buf, size_t size);
 } io_block_ops_t;
 
+#if IO_BLOCK_CACHE
+/*
+ * Maximum number of lines in the read cache of a block device. It can be
+ * overridden by the platform.
+ */
+#ifndef IO_BLOCK_CACHE_MAX_LINES
+#define IO_BLOCK_CACHE_MAX_LINES	8U
+#endif
+
+/*
+ * Optional read cache of a block device. The cache is disabled if line_count
+ * is 0. Each line holds line_size bytes (a multiple of the block size) read
+ * from the device in a single operation, and lines are replaced in least
+ * recently used order.
+ */
+typedef struct io_block_cache_spec {
+	uintptr_t	base;
+	size_t		line_size;
+	unsigned int	line_count;
+} io_block_cache_spec_t;
+
+/* Read cache statistics */
+typedef struct io_block_cache_stats {
+	unsigned int	hits;
+	unsigned int	misses;
+	unsigned int	dev_reads;
+} io_block_cache_stats_t;
+#endif /* IO_BLOCK_CACHE */
+
 typedef struct io_block_dev_spec {
 	io_block_spec_t	buffer;
 	io_block_ops_t	ops;
 	size_t		block_size;
+#if IO_BLOCK_CACHE
+	io_block_cache_spec_t	cache;
+#endif
 } io_block_dev_spec_t;
 
 struct io_dev_connector;
 
 int register_io_dev_block(const struct io_dev_connector **dev_con);
+#if IO_BLOCK_CACHE
+int io_block_get_cache_stats(const io_block_dev_spec_t *dev_spec,
+			     io_block_cache_stats_t *stats);
+#endif
 
 #endif /* IO_BLOCK_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2020, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -11,5 +11,8 @@ struct io_dev_connector;
 
 int register_io_dev_fip(const struct io_dev_connector **dev_con);
 int fip_dev_get_plat_toc_flag(io_dev_info_t *dev_info, uint16_t *plat_toc_flag);
+#if FIP_TOC_CACHE
+void fip_dev_invalidate_toc_cache(void);
+#endif
 
 #endif /* IO_FIP_H */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014-2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2014-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -106,6 +106,15 @@ int io_write(uintptr_t handle, const uintptr_t buffer, size_t length,
  */
 int io_erase(uintptr_t handle, size_t length);
 
+/*
+ * Return the address at which 'length' bytes starting at the current seek
+ * offset of the entity can be accessed directly, and advance the seek offset
+ * past them as io_read() would. Only backends that sit on memory-mapped storage
+ * (memmap, and FIP on top of it) implement this; -ENODEV is returned for the
+ * others, in which case the caller has to fall back on io_read().
+ */
+int io_map(uintptr_t handle, size_t length, uintptr_t *addr);
+
 int io_close(uintptr_t handle);
 
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2019-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -25,6 +25,10 @@
 
 #define IMAGE_ATTRIB_SKIP_LOADING	U(0x02)
 #define IMAGE_ATTRIB_PLAT_SETUP		U(0x04)
+/* Image is accessed in place on memory-mapped storage instead of copied */
+#define IMAGE_ATTRIB_ZERO_COPY		U(0x08)
+/* Image is decompressed while it is read from the storage */
+#define IMAGE_ATTRIB_DECOMPRESS_STREAM	U(0x10)
 
 #define INVALID_IMAGE_ID		U(0xFFFFFFFF)
 
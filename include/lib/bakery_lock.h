@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -93,9 +93,21 @@ typedef bakery_info_t bakery_lock_t;
 #endif /* __USE_COHERENT_MEM__ */
 
 static inline void bakery_lock_init(bakery_lock_t *bakery) {}
-void bakery_lock_get(bakery_lock_t *bakery);
+void bakery_lock_get_range(bakery_lock_t *bakery, unsigned int first_cpu,
+			   unsigned int cpu_count);
 void bakery_lock_release(bakery_lock_t *bakery);
 
+/*
+ * Acquire a bakery lock that any CPU may contend for. Locks only ever taken
+ * by the CPUs of a known range of core positions should be acquired with
+ * bakery_lock_get_range() instead, as only the tickets of those CPUs are then
+ * scanned.
+ */
+static inline void bakery_lock_get(bakery_lock_t *bakery)
+{
+	bakery_lock_get_range(bakery, 0U, BAKERY_LOCK_MAX_CPUS);
+}
+
 #define DEFINE_BAKERY_LOCK(_name) bakery_lock_t _name __section(".bakery_lock")
 
 #define DECLARE_BAKERY_LOCK(_name) extern bakery_lock_t _name
@@ -46,6 +46,7 @@ void cm_el2_sysregs_context_save_gic(uint32_t security_state);
 void cm_el2_sysregs_context_restore_gic(uint32_t security_state);
 void cm_el2_sysregs_context_save(uint32_t security_state);
 void cm_el2_sysregs_context_restore(uint32_t security_state);
+void cm_el2_sysregs_context_switch(uint32_t from_state, uint32_t to_state);
 #else
 void cm_el1_sysregs_context_save(uint32_t security_state);
 void cm_el1_sysregs_context_restore(uint32_t security_state);
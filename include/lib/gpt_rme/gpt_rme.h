@@ -308,7 +308,8 @@ int gpt_enable(void);
  * This function is the core of the granule transition service, including both
  * delegate and undelegate operations. When a granule transition request occurs
  * it is routed to this function which will determine if it is valid and fulfill
- * it.
+ * it. A single call transitions at most the granules up to the end of the 2MB
+ * block containing 'base' that are in the same state as the first one.
  *
  * Parameters
  *   base               Base address of the first granule to transition, aligned
@@ -316,9 +317,9 @@ int gpt_enable(void);
  *   *granule_count     Pointer to a variable containing the number of granules
  *                      to be transitioned. This value will be overwritten with
  *                      the number of granules actually transitioned once this
- *                      function returns. It is possible to return an error part
- *                      way through the process and have a non-zero number of
- *                      granules transitioned. TODO is this acceptable?
+ *                      function returns, which may be fewer than requested.
+ *                      An error is only returned if no granule was
+ *                      transitioned.
  *   target_gpi         GPI to transition the granules to.
  *   src_sec_state      Security state of the requesting entity. This will be
  *                      combined with target_gpi to determine whether a
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2024, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -57,6 +57,9 @@
 #define PMF_SMC_GET_VERSION_32		U(0x87000021)
 #define PMF_SMC_GET_VERSION_64		U(0xC7000021)
 
+#define PMF_SMC_GET_SMC_HIST_32		U(0x87000022)
+#define PMF_SMC_GET_SMC_HIST_64		U(0xC7000022)
+
 #define PMF_SMC_VERSION			U(0x00000001)
 
 /*
@@ -71,6 +74,31 @@
 #define PMF_PSCI_STAT_SVC_ID	0
 #define PMF_RT_INSTR_SVC_ID	1
 
+#if ENABLE_SMC_LATENCY_HIST
+/*
+ * SMC latency histograms. Each CPU tracks up to PMF_SMC_HIST_MAX_FIDS function
+ * IDs, the SMCs with other function IDs are only counted as dropped. Bucket 0
+ * counts the SMCs handled in less than 1 tick of the generic counter, bucket
+ * n > 0 those handled in [2^(n-1), 2^n) ticks. The last bucket also counts all
+ * the longer ones.
+ */
+#ifndef PMF_SMC_HIST_MAX_FIDS
+#define PMF_SMC_HIST_MAX_FIDS		U(16)
+#endif
+#define PMF_SMC_HIST_BUCKETS		U(32)
+
+typedef struct pmf_smc_hist_entry {
+	uint32_t smc_fid;
+	uint32_t count[PMF_SMC_HIST_BUCKETS];
+} pmf_smc_hist_entry_t;
+
+typedef struct pmf_smc_hist {
+	uint32_t dropped;
+	uint32_t num_entries;
+	pmf_smc_hist_entry_t entries[PMF_SMC_HIST_MAX_FIDS];
+} pmf_smc_hist_t;
+#endif /* ENABLE_SMC_LATENCY_HIST */
+
 /*******************************************************************************
  * Function & variable prototypes
  ******************************************************************************/
@@ -89,4 +117,13 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		void *handle,
 		u_register_t flags);
 
+#if ENABLE_SMC_LATENCY_HIST
+void pmf_smc_hist_start(uint32_t smc_fid);
+void pmf_smc_hist_end(void);
+void pmf_smc_hist_record(uint32_t smc_fid, uint64_t ticks);
+int pmf_smc_hist_get(uint32_t smc_fid, u_register_t mpidr,
+		unsigned int bucket, uint32_t *count);
+const pmf_smc_hist_t *pmf_smc_hist_by_index(unsigned int cpu_idx);
+#endif /* ENABLE_SMC_LATENCY_HIST */
+
 #endif /* PMF_H */
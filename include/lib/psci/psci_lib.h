@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,6 +14,12 @@
 #include <cdefs.h>
 #include <stdint.h>
 
+/*
+ * Vendor-specific EL3 Monitor Service Call turning on several CPUs at once,
+ * handled by psci_cpu_on_bulk().
+ */
+#define PSCI_BULK_CPU_ON_SMC64		U(0xC7000050)
+
 /*******************************************************************************
  * Optional structure populated by the Secure Payload Dispatcher to be given a
  * chance to perform any bookkeeping before PSCI executes a power management
@@ -99,6 +105,11 @@ void __dead2 psci_pwrdown_cpu_end_terminal(void);
 void psci_pwrdown_cpu_end_wakeup(unsigned int power_level);
 void psci_do_manage_extensions(void);
 unsigned int psci_num_cpus_running_on_safe(unsigned int this_core);
+#if PSCI_BULK_CPU_ON
+int psci_cpu_on_bulk(u_register_t target_aff, u_register_t aff0_mask,
+		     uintptr_t entrypoint, u_register_t context_id,
+		     u_register_t *on_mask);
+#endif
 
 #endif /* __ASSEMBLER__ */
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -13,4 +13,9 @@
 int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	   size_t out_len, uintptr_t work_buf, size_t work_len);
 
+int gunzip_stream_start(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+			size_t work_len);
+int gunzip_stream_update(uintptr_t in_buf, size_t in_len);
+int gunzip_stream_finish(uintptr_t *out_buf);
+
 #endif /* TF_GUNZIP_H */
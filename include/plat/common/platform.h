@@ -46,7 +46,9 @@ enum fw_enc_status_t;
 
 /*******************************************************************************
  * Structure populated by platform specific code to export routines which
- * perform load images functions, and associated pointer to platform ops
+ * perform load images functions, and associated pointer to platform ops.
+ * A next_instance() which moves the FIP behind the same backend image spec
+ * must call fip_dev_invalidate_toc_cache() when FIP_TOC_CACHE is enabled.
  ******************************************************************************/
 struct plat_try_images_ops {
 	int (*next_instance)(unsigned int image_id);
@@ -384,6 +386,8 @@ void plat_psci_stat_accounting_stop(const psci_power_state_t *state_info);
 u_register_t plat_psci_stat_get_residency(unsigned int lvl,
 			const psci_power_state_t *state_info,
 			unsigned int last_cpu_idx);
+u_register_t plat_psci_idle_break_even_time(unsigned int lvl,
+			plat_local_state_t local_state);
 plat_local_state_t plat_get_target_pwr_state(unsigned int lvl,
 			const plat_local_state_t *states,
 			unsigned int ncpu);
@@ -492,6 +496,9 @@ struct ffa_mtd;
 int plat_spmc_shmem_datastore_get(uint8_t **datastore, size_t *size);
 int plat_spmc_shmem_begin(struct ffa_mtd *desc);
 int plat_spmc_shmem_reclaim(struct ffa_mtd *desc);
+#if SPMC_DEFER_SP_LOAD
+int plat_spmc_sp_load(uint16_t sp_id);
+#endif
 #endif
 
 /*******************************************************************************
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,6 +14,25 @@
 #include <services/ffa_svc.h>
 #include <services/spm_core_manifest.h>
 
+/*
+ * Batched direct requests, a vendor-specific EL3 Monitor service call of the
+ * SPMC at EL3. Only available when SPMC_DIRECT_MSG_BATCH is enabled.
+ */
+#define SPMC_DIRECT_REQ_BATCH_SMC64	U(0xC7000060)
+
+/*
+ * Entry of the array of direct requests passed in the TX buffer to
+ * SPMC_DIRECT_REQ_BATCH_SMC64. @args holds the x3-x7 payload of the request.
+ * The completion of each request is written to the entry with the same index
+ * in the RX buffer, with the payload of the response and a 0 @status, or the
+ * FF-A error code the partition returned instead of a response.
+ */
+struct spmc_direct_batch_entry {
+	int32_t status;
+	uint32_t reserved;
+	uint64_t args[5];
+};
+
 int spmc_setup(void);
 void spmc_populate_attrs(spmc_manifest_attribute_t *spmc_attrs);
 void *spmc_get_config_addr(void);
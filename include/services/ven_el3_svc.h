@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2024, Arm Limited. All rights reserved.
+ * Copyright (c) 2024-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -21,7 +21,7 @@
 #define VEN_EL3_SVC_VERSION	0x8700ff03
 
 #define VEN_EL3_SVC_VERSION_MAJOR	1
-#define VEN_EL3_SVC_VERSION_MINOR	2
+#define VEN_EL3_SVC_VERSION_MINOR	5
 
 /* DEBUGFS_SMC_32		0x87000010U */
 /* DEBUGFS_SMC_64		0xC7000010U */
@@ -35,4 +35,8 @@
 /* TPM_START_SMC_32		0x87000040U */
 /* TPM_START_SMC_64		0xC7000040U */
 
+/* PSCI_BULK_CPU_ON_SMC64	0xC7000050U */
+
+/* SPMC_DIRECT_REQ_BATCH_SMC64	0xC7000060U */
+
 #endif /* VEN_EL3_SVC_H */
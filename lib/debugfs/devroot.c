@@ -1,12 +1,18 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2026, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
+#include <string.h>
+
+#include <platform_def.h>
+
 #include <common/debug.h>
 #include <lib/debugfs.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
 
 #include "blobs.h"
 #include "dev.h"
@@ -21,6 +27,10 @@ static const dirtab_t dirtab[] = {
 };
 
 static const dirtab_t devfstab[] = {
+#if ENABLE_SMC_LATENCY_HIST
+	{"smchist", DEV_ROOT_QSMCHIST,
+	 PLATFORM_CORE_COUNT * sizeof(pmf_smc_hist_t), O_READ}
+#endif
 };
 
 /*******************************************************************************
@@ -50,6 +60,33 @@ static int rootgen(chan_t *channel, const dirtab_t *tab, int ntab,
 	return devgen(channel, tab, ntab, n, dir);
 }
 
+#if ENABLE_SMC_LATENCY_HIST
+/*******************************************************************************
+ * This function copies the SMC latency histograms of all the CPUs, as an array
+ * of pmf_smc_hist_t ordered by CPU index. Each read stops at the end of the
+ * histograms of a CPU.
+ ******************************************************************************/
+static int smchistread(chan_t *channel, void *buf, int size)
+{
+	const size_t hist_size = sizeof(pmf_smc_hist_t);
+	unsigned long cpu_idx = channel->offset / hist_size;
+	unsigned long offset = channel->offset % hist_size;
+	size_t nbytes;
+
+	if ((size < 0) || (cpu_idx >= PLATFORM_CORE_COUNT)) {
+		return -1;
+	}
+
+	nbytes = MIN((size_t)size, hist_size - offset);
+	memcpy(buf, (const char *)pmf_smc_hist_by_index(cpu_idx) + offset,
+	       nbytes);
+
+	channel->offset += nbytes;
+
+	return (int)nbytes;
+}
+#endif /* ENABLE_SMC_LATENCY_HIST */
+
 static int rootwalk(chan_t *channel, const char *name)
 {
 	return devwalk(channel, name, NULL, 0, rootgen);
@@ -72,6 +109,12 @@ static int rootread(chan_t *channel, void *buf, int size)
 		return dirread(channel, dir, NULL, 0, rootgen);
 	}
 
+#if ENABLE_SMC_LATENCY_HIST
+	if (channel->qid == DEV_ROOT_QSMCHIST) {
+		return smchistread(channel, buf, size);
+	}
+#endif
+
 	/* Only makes sense when using debug language */
 	assert(channel->qid != DEV_ROOT_QBLOBCTL);
 
@@ -1304,6 +1304,26 @@ void cm_sysregs_context_restore_amu(unsigned int security_state)
 
 #if (CTX_INCLUDE_EL2_REGS && defined(IMAGE_BL31))
 
+/*
+ * Write an EL2 register from the context 'ctx'. 'live' may point to a context
+ * which was just saved from the registers, in which case they are known to hold
+ * its values and, with CTX_EL2_LAZY_RESTORE, the registers which would be
+ * written with the value they already hold are skipped.
+ */
+#if CTX_EL2_LAZY_RESTORE
+#define restore_el2_ctx(ctx, live, grp, reg)				\
+	do {								\
+		if (((live) == NULL) ||					\
+		    (read_el2_ctx_##grp(live, reg) !=			\
+		     read_el2_ctx_##grp(ctx, reg))) {			\
+			write_##reg(read_el2_ctx_##grp(ctx, reg));	\
+		}							\
+	} while (false)
+#else
+#define restore_el2_ctx(ctx, live, grp, reg)				\
+	write_##reg(read_el2_ctx_##grp(ctx, reg))
+#endif /* CTX_EL2_LAZY_RESTORE */
+
 static void el2_sysregs_context_save_fgt(el2_sysregs_t *ctx)
 {
 	write_el2_ctx_fgt(ctx, hdfgrtr_el2, read_hdfgrtr_el2());
@@ -1316,16 +1336,17 @@ static void el2_sysregs_context_save_fgt(el2_sysregs_t *ctx)
 	write_el2_ctx_fgt(ctx, hfgwtr_el2, read_hfgwtr_el2());
 }
 
-static void el2_sysregs_context_restore_fgt(el2_sysregs_t *ctx)
+static void el2_sysregs_context_restore_fgt(el2_sysregs_t *ctx,
+						const el2_sysregs_t *live)
 {
-	write_hdfgrtr_el2(read_el2_ctx_fgt(ctx, hdfgrtr_el2));
+	restore_el2_ctx(ctx, live, fgt, hdfgrtr_el2);
 	if (is_feat_amu_supported()) {
-		write_hafgrtr_el2(read_el2_ctx_fgt(ctx, hafgrtr_el2));
+		restore_el2_ctx(ctx, live, fgt, hafgrtr_el2);
 	}
-	write_hdfgwtr_el2(read_el2_ctx_fgt(ctx, hdfgwtr_el2));
-	write_hfgitr_el2(read_el2_ctx_fgt(ctx, hfgitr_el2));
-	write_hfgrtr_el2(read_el2_ctx_fgt(ctx, hfgrtr_el2));
-	write_hfgwtr_el2(read_el2_ctx_fgt(ctx, hfgwtr_el2));
+	restore_el2_ctx(ctx, live, fgt, hdfgwtr_el2);
+	restore_el2_ctx(ctx, live, fgt, hfgitr_el2);
+	restore_el2_ctx(ctx, live, fgt, hfgrtr_el2);
+	restore_el2_ctx(ctx, live, fgt, hfgwtr_el2);
 }
 
 static void el2_sysregs_context_save_fgt2(el2_sysregs_t *ctx)
@@ -1337,13 +1358,14 @@ static void el2_sysregs_context_save_fgt2(el2_sysregs_t *ctx)
 	write_el2_ctx_fgt2(ctx, hfgwtr2_el2, read_hfgwtr2_el2());
 }
 
-static void el2_sysregs_context_restore_fgt2(el2_sysregs_t *ctx)
+static void el2_sysregs_context_restore_fgt2(el2_sysregs_t *ctx,
+						const el2_sysregs_t *live)
 {
-	write_hdfgrtr2_el2(read_el2_ctx_fgt2(ctx, hdfgrtr2_el2));
-	write_hdfgwtr2_el2(read_el2_ctx_fgt2(ctx, hdfgwtr2_el2));
-	write_hfgitr2_el2(read_el2_ctx_fgt2(ctx, hfgitr2_el2));
-	write_hfgrtr2_el2(read_el2_ctx_fgt2(ctx, hfgrtr2_el2));
-	write_hfgwtr2_el2(read_el2_ctx_fgt2(ctx, hfgwtr2_el2));
+	restore_el2_ctx(ctx, live, fgt2, hdfgrtr2_el2);
+	restore_el2_ctx(ctx, live, fgt2, hdfgwtr2_el2);
+	restore_el2_ctx(ctx, live, fgt2, hfgitr2_el2);
+	restore_el2_ctx(ctx, live, fgt2, hfgrtr2_el2);
+	restore_el2_ctx(ctx, live, fgt2, hfgwtr2_el2);
 }
 
 static void el2_sysregs_context_save_mpam(el2_sysregs_t *ctx)
@@ -1397,41 +1419,42 @@ static void el2_sysregs_context_save_mpam(el2_sysregs_t *ctx)
 	}
 }
 
-static void el2_sysregs_context_restore_mpam(el2_sysregs_t *ctx)
+static void el2_sysregs_context_restore_mpam(el2_sysregs_t *ctx,
+						const el2_sysregs_t *live)
 {
 	u_register_t mpam_idr = read_mpamidr_el1();
 
-	write_mpam2_el2(read_el2_ctx_mpam(ctx, mpam2_el2));
+	restore_el2_ctx(ctx, live, mpam, mpam2_el2);
 
 	if ((mpam_idr & MPAMIDR_HAS_HCR_BIT) == 0U) {
 		return;
 	}
 
-	write_mpamhcr_el2(read_el2_ctx_mpam(ctx, mpamhcr_el2));
-	write_mpamvpm0_el2(read_el2_ctx_mpam(ctx, mpamvpm0_el2));
-	write_mpamvpmv_el2(read_el2_ctx_mpam(ctx, mpamvpmv_el2));
+	restore_el2_ctx(ctx, live, mpam, mpamhcr_el2);
+	restore_el2_ctx(ctx, live, mpam, mpamvpm0_el2);
+	restore_el2_ctx(ctx, live, mpam, mpamvpmv_el2);
 
 	switch ((mpam_idr >> MPAMIDR_EL1_VPMR_MAX_SHIFT) & MPAMIDR_EL1_VPMR_MAX_MASK) {
 	case 7:
-		write_mpamvpm7_el2(read_el2_ctx_mpam(ctx, mpamvpm7_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm7_el2);
 		__fallthrough;
 	case 6:
-		write_mpamvpm6_el2(read_el2_ctx_mpam(ctx, mpamvpm6_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm6_el2);
 		__fallthrough;
 	case 5:
-		write_mpamvpm5_el2(read_el2_ctx_mpam(ctx, mpamvpm5_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm5_el2);
 		__fallthrough;
 	case 4:
-		write_mpamvpm4_el2(read_el2_ctx_mpam(ctx, mpamvpm4_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm4_el2);
 		__fallthrough;
 	case 3:
-		write_mpamvpm3_el2(read_el2_ctx_mpam(ctx, mpamvpm3_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm3_el2);
 		__fallthrough;
 	case 2:
-		write_mpamvpm2_el2(read_el2_ctx_mpam(ctx, mpamvpm2_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm2_el2);
 		__fallthrough;
 	case 1:
-		write_mpamvpm1_el2(read_el2_ctx_mpam(ctx, mpamvpm1_el2));
+		restore_el2_ctx(ctx, live, mpam, mpamvpm1_el2);
 		break;
 	}
 }
@@ -1560,38 +1583,39 @@ static void el2_sysregs_context_save_common(el2_sysregs_t *ctx)
 	write_el2_ctx_common_sysreg128(ctx, vttbr_el2, read_vttbr_el2());
 }
 
-static void el2_sysregs_context_restore_common(el2_sysregs_t *ctx)
+static void el2_sysregs_context_restore_common(el2_sysregs_t *ctx,
+						const el2_sysregs_t *live)
 {
-	write_actlr_el2(read_el2_ctx_common(ctx, actlr_el2));
-	write_afsr0_el2(read_el2_ctx_common(ctx, afsr0_el2));
-	write_afsr1_el2(read_el2_ctx_common(ctx, afsr1_el2));
-	write_amair_el2(read_el2_ctx_common(ctx, amair_el2));
-	write_cnthctl_el2(read_el2_ctx_common(ctx, cnthctl_el2));
-	write_cntvoff_el2(read_el2_ctx_common(ctx, cntvoff_el2));
-	write_cptr_el2(read_el2_ctx_common(ctx, cptr_el2));
+	restore_el2_ctx(ctx, live, common, actlr_el2);
+	restore_el2_ctx(ctx, live, common, afsr0_el2);
+	restore_el2_ctx(ctx, live, common, afsr1_el2);
+	restore_el2_ctx(ctx, live, common, amair_el2);
+	restore_el2_ctx(ctx, live, common, cnthctl_el2);
+	restore_el2_ctx(ctx, live, common, cntvoff_el2);
+	restore_el2_ctx(ctx, live, common, cptr_el2);
 	if (CTX_INCLUDE_AARCH32_REGS) {
-		write_dbgvcr32_el2(read_el2_ctx_common(ctx, dbgvcr32_el2));
-	}
-	write_elr_el2(read_el2_ctx_common(ctx, elr_el2));
-	write_esr_el2(read_el2_ctx_common(ctx, esr_el2));
-	write_far_el2(read_el2_ctx_common(ctx, far_el2));
-	write_hacr_el2(read_el2_ctx_common(ctx, hacr_el2));
-	write_hcr_el2(read_el2_ctx_common(ctx, hcr_el2));
-	write_hpfar_el2(read_el2_ctx_common(ctx, hpfar_el2));
-	write_hstr_el2(read_el2_ctx_common(ctx, hstr_el2));
-	write_mair_el2(read_el2_ctx_common(ctx, mair_el2));
-	write_mdcr_el2(read_el2_ctx_common(ctx, mdcr_el2));
-	write_sctlr_el2(read_el2_ctx_common(ctx, sctlr_el2));
-	write_spsr_el2(read_el2_ctx_common(ctx, spsr_el2));
-	write_sp_el2(read_el2_ctx_common(ctx, sp_el2));
-	write_tcr_el2(read_el2_ctx_common(ctx, tcr_el2));
-	write_tpidr_el2(read_el2_ctx_common(ctx, tpidr_el2));
-	write_ttbr0_el2(read_el2_ctx_common(ctx, ttbr0_el2));
-	write_vbar_el2(read_el2_ctx_common(ctx, vbar_el2));
-	write_vmpidr_el2(read_el2_ctx_common(ctx, vmpidr_el2));
-	write_vpidr_el2(read_el2_ctx_common(ctx, vpidr_el2));
-	write_vtcr_el2(read_el2_ctx_common(ctx, vtcr_el2));
-	write_vttbr_el2(read_el2_ctx_common(ctx, vttbr_el2));
+		restore_el2_ctx(ctx, live, common, dbgvcr32_el2);
+	}
+	restore_el2_ctx(ctx, live, common, elr_el2);
+	restore_el2_ctx(ctx, live, common, esr_el2);
+	restore_el2_ctx(ctx, live, common, far_el2);
+	restore_el2_ctx(ctx, live, common, hacr_el2);
+	restore_el2_ctx(ctx, live, common, hcr_el2);
+	restore_el2_ctx(ctx, live, common, hpfar_el2);
+	restore_el2_ctx(ctx, live, common, hstr_el2);
+	restore_el2_ctx(ctx, live, common, mair_el2);
+	restore_el2_ctx(ctx, live, common, mdcr_el2);
+	restore_el2_ctx(ctx, live, common, sctlr_el2);
+	restore_el2_ctx(ctx, live, common, spsr_el2);
+	restore_el2_ctx(ctx, live, common, sp_el2);
+	restore_el2_ctx(ctx, live, common, tcr_el2);
+	restore_el2_ctx(ctx, live, common, tpidr_el2);
+	restore_el2_ctx(ctx, live, common, ttbr0_el2);
+	restore_el2_ctx(ctx, live, common, vbar_el2);
+	restore_el2_ctx(ctx, live, common, vmpidr_el2);
+	restore_el2_ctx(ctx, live, common, vpidr_el2);
+	restore_el2_ctx(ctx, live, common, vtcr_el2);
+	restore_el2_ctx(ctx, live, common, vttbr_el2);
 }
 
 /*******************************************************************************
@@ -1693,9 +1717,11 @@ void cm_el2_sysregs_context_save(uint32_t security_state)
 }
 
 /*******************************************************************************
- * Restore EL2 sysreg context
+ * Restore EL2 sysreg context. 'live' is either NULL or the context that was
+ * just saved from the registers, see restore_el2_ctx().
  ******************************************************************************/
-void cm_el2_sysregs_context_restore(uint32_t security_state)
+static void el2_sysregs_context_restore(uint32_t security_state,
+					const el2_sysregs_t *live)
 {
 	cpu_context_t *ctx;
 	el2_sysregs_t *el2_sysregs_ctx;
@@ -1705,90 +1731,108 @@ void cm_el2_sysregs_context_restore(uint32_t security_state)
 
 	el2_sysregs_ctx = get_el2_sysregs_ctx(ctx);
 
-	el2_sysregs_context_restore_common(el2_sysregs_ctx);
+	el2_sysregs_context_restore_common(el2_sysregs_ctx, live);
 
 	if (is_feat_mte2_supported()) {
-		write_tfsr_el2(read_el2_ctx_mte2(el2_sysregs_ctx, tfsr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, mte2, tfsr_el2);
 	}
 
 	if (is_feat_mpam_supported()) {
-		el2_sysregs_context_restore_mpam(el2_sysregs_ctx);
+		el2_sysregs_context_restore_mpam(el2_sysregs_ctx, live);
 	}
 
 	if (is_feat_fgt_supported()) {
-		el2_sysregs_context_restore_fgt(el2_sysregs_ctx);
+		el2_sysregs_context_restore_fgt(el2_sysregs_ctx, live);
 	}
 
 	if (is_feat_fgt2_supported()) {
-		el2_sysregs_context_restore_fgt2(el2_sysregs_ctx);
+		el2_sysregs_context_restore_fgt2(el2_sysregs_ctx, live);
 	}
 
 	if (is_feat_ecv_v2_supported()) {
-		write_cntpoff_el2(read_el2_ctx_ecv(el2_sysregs_ctx, cntpoff_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, ecv, cntpoff_el2);
 	}
 
 	if (is_feat_vhe_supported()) {
-		write_contextidr_el2(read_el2_ctx_vhe(el2_sysregs_ctx,
-					contextidr_el2));
-		write_ttbr1_el2(read_el2_ctx_vhe(el2_sysregs_ctx, ttbr1_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, vhe, contextidr_el2);
+		restore_el2_ctx(el2_sysregs_ctx, live, vhe, ttbr1_el2);
 	}
 
 	if (is_feat_ras_supported()) {
-		write_vdisr_el2(read_el2_ctx_ras(el2_sysregs_ctx, vdisr_el2));
-		write_vsesr_el2(read_el2_ctx_ras(el2_sysregs_ctx, vsesr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, ras, vdisr_el2);
+		restore_el2_ctx(el2_sysregs_ctx, live, ras, vsesr_el2);
 	}
 
 	if (is_feat_nv2_supported()) {
-		write_vncr_el2(read_el2_ctx_neve(el2_sysregs_ctx, vncr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, neve, vncr_el2);
 	}
 
 	if (is_feat_trf_supported()) {
-		write_trfcr_el2(read_el2_ctx_trf(el2_sysregs_ctx, trfcr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, trf, trfcr_el2);
 	}
 
 	if (is_feat_csv2_2_supported()) {
-		write_scxtnum_el2(read_el2_ctx_csv2_2(el2_sysregs_ctx,
-					scxtnum_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, csv2_2, scxtnum_el2);
 	}
 
 	if (is_feat_hcx_supported()) {
-		write_hcrx_el2(read_el2_ctx_hcx(el2_sysregs_ctx, hcrx_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, hcx, hcrx_el2);
 	}
 
 	if (is_feat_tcr2_supported()) {
-		write_tcr2_el2(read_el2_ctx_tcr2(el2_sysregs_ctx, tcr2_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, tcr2, tcr2_el2);
 	}
 
 	if (is_feat_s1pie_supported()) {
-		write_pire0_el2(read_el2_ctx_sxpie(el2_sysregs_ctx, pire0_el2));
-		write_pir_el2(read_el2_ctx_sxpie(el2_sysregs_ctx, pir_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, sxpie, pire0_el2);
+		restore_el2_ctx(el2_sysregs_ctx, live, sxpie, pir_el2);
 	}
 
 	if (is_feat_s1poe_supported()) {
-		write_por_el2(read_el2_ctx_sxpoe(el2_sysregs_ctx, por_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, sxpoe, por_el2);
 	}
 
 	if (is_feat_s2pie_supported()) {
-		write_s2pir_el2(read_el2_ctx_s2pie(el2_sysregs_ctx, s2pir_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, s2pie, s2pir_el2);
 	}
 
 	if (is_feat_gcs_supported()) {
-		write_gcscr_el2(read_el2_ctx_gcs(el2_sysregs_ctx, gcscr_el2));
-		write_gcspr_el2(read_el2_ctx_gcs(el2_sysregs_ctx, gcspr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, gcs, gcscr_el2);
+		restore_el2_ctx(el2_sysregs_ctx, live, gcs, gcspr_el2);
 	}
 
 	if (is_feat_sctlr2_supported()) {
-		write_sctlr2_el2(read_el2_ctx_sctlr2(el2_sysregs_ctx, sctlr2_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, sctlr2, sctlr2_el2);
 	}
 
 	if (is_feat_brbe_supported()) {
-		write_brbcr_el2(read_el2_ctx_brbe(el2_sysregs_ctx, brbcr_el2));
+		restore_el2_ctx(el2_sysregs_ctx, live, brbe, brbcr_el2);
 	}
 
 	if (is_feat_amu_supported()) {
 		cm_sysregs_context_restore_amu(security_state);
 	}
 }
+
+void cm_el2_sysregs_context_restore(uint32_t security_state)
+{
+	el2_sysregs_context_restore(security_state, NULL);
+}
+
+/*******************************************************************************
+ * Save the EL2 sysreg context of 'from_state' and restore the one of
+ * 'to_state'. Meant for world switches, where it avoids writing the registers
+ * which hold the same value in both contexts when CTX_EL2_LAZY_RESTORE is set.
+ ******************************************************************************/
+void cm_el2_sysregs_context_switch(uint32_t from_state, uint32_t to_state)
+{
+	cpu_context_t *from_ctx = cm_get_context(from_state);
+
+	assert(from_ctx != NULL);
+
+	cm_el2_sysregs_context_save(from_state);
+	el2_sysregs_context_restore(to_state, get_el2_sysregs_ctx(from_ctx));
+}
 #endif /* (CTX_INCLUDE_EL2_REGS && IMAGE_BL31) */
 
 /*******************************************************************************
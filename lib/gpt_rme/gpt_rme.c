@@ -156,6 +156,9 @@ static uint64_t gpt_l1_index_mask;
 #define L1_QWORDS_32MB	(L1_QWORDS_2MB * 16U)
 #define L1_QWORDS_512MB	(L1_QWORDS_32MB * 16U)
 
+/* Number of granules described by an L1 Granules descriptor */
+#define GPT_L1_GRAN_DESC_GPIS	16U
+
 /* Size in bytes of L1 entries in 2MB, 32MB */
 #define L1_BYTES_2MB	(gpt_l1_cnt_2mb * sizeof(uint64_t))
 #define L1_BYTES_32MB	(L1_BYTES_2MB * 16U)
@@ -203,7 +206,12 @@ static bitlock_t *gpt_bitlock;
 #define GPT_UNLOCK	bit_unlock(gpi_info.lock, gpi_info.mask)
 #endif /* RME_GPT_BITLOCK_BLOCK */
 
-static void tlbi_page_dsbosh(uintptr_t base)
+/*
+ * Invalidate the TLB entries of 'cnt' contiguous granules starting at 'base',
+ * which must not cross a 2MB boundary, and wait for the invalidation to
+ * complete.
+ */
+static void tlbi_pages_dsbosh(uintptr_t base, unsigned int cnt)
 {
 	/* Look-up table for invalidation TLBs for 4KB, 16KB and 64KB pages */
 	static const gpt_tlbi_lookup_t tlbi_page_lookup[] = {
@@ -211,9 +219,19 @@ static void tlbi_page_dsbosh(uintptr_t base)
 		{ tlbirpalos_64k, ~(SZ_64K - 1UL) },
 		{ tlbirpalos_16k, ~(SZ_16K - 1UL) }
 	};
+	size_t gran_size = GPT_PGS_ACTUAL_SIZE(gpt_config.p);
+
+	if (((size_t)cnt * gran_size) == SZ_2M) {
+		/* The whole 2MB block, invalidate it with a single operation */
+		tlbirpalos_2m(ALIGN_2MB(base));
+	} else {
+		for (unsigned int i = 0U; i < cnt; i++) {
+			tlbi_page_lookup[gpt_config.pgs].function(
+				(base + (i * gran_size)) &
+				tlbi_page_lookup[gpt_config.pgs].mask);
+		}
+	}
 
-	tlbi_page_lookup[gpt_config.pgs].function(
-			base & tlbi_page_lookup[gpt_config.pgs].mask);
 	dsbosh();
 }
 
@@ -1495,10 +1513,8 @@ static void read_gpi(gpi_info_t *gpi_info)
 	}
 }
 
-static void flush_page_to_popa(uintptr_t addr)
+static void flush_range_to_popa(uintptr_t addr, size_t size)
 {
-	size_t size = GPT_PGS_ACTUAL_SIZE(gpt_config.p);
-
 	if (is_feat_mte2_supported()) {
 		flush_dcache_to_popa_range_mte2(addr, size);
 	} else {
@@ -1763,58 +1779,118 @@ __unused static void shatter_block(uint64_t base, gpi_info_t *gpi_info,
 	gpi_info->gpt_l1_desc = l1_desc;
 }
 
-static inline void gpt_write_entry(uint64_t base, uint8_t target_gpi,
-				   gpi_info_t *gpi_info)
+/*
+ * Helper to set the GPI of 'cnt' contiguous granules starting at 'base' in the
+ * L1 table, writing whole descriptors at once where all their granules change.
+ * The GPI information in 'gpi_info' is updated with the new descriptor of the
+ * first granule.
+ */
+static void write_gpt_range(uint64_t base, unsigned int cnt,
+			    unsigned int target_gpi, gpi_info_t *gpi_info)
+{
+	size_t gran_size = GPT_PGS_ACTUAL_SIZE(gpt_config.p);
+	uint64_t *l1 = gpi_info->gpt_l1_addr;
+	unsigned int i = 0U;
+
+	while (i < cnt) {
+		uint64_t pa = base + (i * gran_size);
+		unsigned long idx = GPT_L1_INDEX(pa);
+		unsigned int gpi_shift = GPT_L1_GPI_IDX(gpt_config.p, pa) << 2;
+
+		if ((gpi_shift == 0U) && ((cnt - i) >= GPT_L1_GRAN_DESC_GPIS)) {
+			/* All the granules of this descriptor change */
+			l1[idx] = GPI_TO_DESC(target_gpi);
+			i += GPT_L1_GRAN_DESC_GPIS;
+		} else {
+			l1[idx] &= ~(GPT_L1_GRAN_DESC_GPI_MASK << gpi_shift);
+			l1[idx] |= ((uint64_t)target_gpi << gpi_shift);
+			i++;
+		}
+	}
+
+	gpi_info->gpt_l1_desc = l1[gpi_info->idx];
+
+	dsboshst();
+}
+
+static inline void gpt_write_entries(uint64_t base, unsigned int cnt,
+				     uint8_t target_gpi, gpi_info_t *gpi_info)
 {
-	/* Update the GPI entry to the new state. */
-	write_gpt(&gpi_info->gpt_l1_desc, gpi_info->gpt_l1_addr,
-		  gpi_info->gpi_shift, gpi_info->idx, target_gpi);
+	/* Update the GPI entries to the new state. */
+	write_gpt_range(base, cnt, target_gpi, gpi_info);
 
 	/* Ensure all agents observe new state. */
-	tlbi_page_dsbosh(base);
+	tlbi_pages_dsbosh(base, cnt);
 }
 
-static inline void gpt_delegate(uint64_t base, uint8_t target_gpi,
-				gpi_info_t *gpi_info)
+static inline void gpt_delegate(uint64_t base, unsigned int cnt,
+				uint8_t target_gpi, gpi_info_t *gpi_info)
 {
 	uint8_t source_gpi = gpi_info->gpi;
+	size_t size = (size_t)cnt * GPT_PGS_ACTUAL_SIZE(gpt_config.p);
 
 	/*
 	 * In order to maintain mutual distrust between states, remove any data
 	 * speculatively fetched into the target physical address space.
 	 */
-	flush_page_to_popa(base | GPI_TO_NSE(target_gpi));
+	flush_range_to_popa(base | GPI_TO_NSE(target_gpi), size);
 
-	gpt_write_entry(base, target_gpi, gpi_info);
+	gpt_write_entries(base, cnt, target_gpi, gpi_info);
 
 	/* Ensure scrubbed data has made it past PoPA */
-	flush_page_to_popa(base | GPI_TO_NSE(source_gpi));
+	flush_range_to_popa(base | GPI_TO_NSE(source_gpi), size);
 }
 
-static inline void gpt_undelegate(uint64_t base, uint8_t target_gpi,
-				  gpi_info_t *gpi_info)
+static inline void gpt_undelegate(uint64_t base, unsigned int cnt,
+				  uint8_t target_gpi, gpi_info_t *gpi_info)
 {
 	uint8_t source_gpi = gpi_info->gpi;
+	size_t size = (size_t)cnt * GPT_PGS_ACTUAL_SIZE(gpt_config.p);
 
 	/*
 	 * In order to maintain mutual distrust between states, remove access
 	 * now, in order to guarantee that writes to the currently-accessible
 	 * physical address space will not later become observable.
 	 */
-	write_gpt(&gpi_info->gpt_l1_desc, gpi_info->gpt_l1_addr,
-		  gpi_info->gpi_shift, gpi_info->idx, GPT_GPI_NO_ACCESS);
+	write_gpt_range(base, cnt, GPT_GPI_NO_ACCESS, gpi_info);
 
 	/* Ensure all agents observe NO ACCESS state. */
-	tlbi_page_dsbosh(base);
+	tlbi_pages_dsbosh(base, cnt);
 
 	/*
 	 * Ensure that the scrubbed data have made it past the PoPA for both
 	 * old and new security states.
 	 */
-	flush_page_to_popa(base | GPI_TO_NSE(source_gpi));
-	flush_page_to_popa(base | GPI_TO_NSE(target_gpi));
+	flush_range_to_popa(base | GPI_TO_NSE(source_gpi), size);
+	flush_range_to_popa(base | GPI_TO_NSE(target_gpi), size);
 
-	gpt_write_entry(base, target_gpi, gpi_info);
+	gpt_write_entries(base, cnt, target_gpi, gpi_info);
+}
+
+/*
+ * Helper to count how many of the 'cnt' granules starting at 'base' currently
+ * have the same GPI as the first one, which 'gpi_info' holds. The granules must
+ * not cross a 2MB boundary and be described by Granules descriptors. This
+ * function is called with bitlock or spinlock acquired.
+ */
+static unsigned int count_same_gpi(uint64_t base, unsigned int cnt,
+				   const gpi_info_t *gpi_info)
+{
+	size_t gran_size = GPT_PGS_ACTUAL_SIZE(gpt_config.p);
+	unsigned int i;
+
+	for (i = 1U; i < cnt; i++) {
+		uint64_t pa = base + (i * gran_size);
+		uint64_t l1_desc = gpi_info->gpt_l1_addr[GPT_L1_INDEX(pa)];
+		unsigned int gpi_shift = GPT_L1_GPI_IDX(gpt_config.p, pa) << 2;
+
+		if (((l1_desc >> gpi_shift) & GPT_L1_GRAN_DESC_GPI_MASK) !=
+		    gpi_info->gpi) {
+			break;
+		}
+	}
+
+	return i;
 }
 
 /*
@@ -1823,15 +1899,21 @@ static inline void gpt_undelegate(uint64_t base, uint8_t target_gpi,
  * it is routed to this function which will determine if it is valid and fulfill
  * it.
  *
+ * The granules are transitioned in batches sharing a single lock acquisition,
+ * TLB invalidation and cache maintenance. A batch stops at the end of the 2MB
+ * block containing 'base' or at the first granule whose GPI differs from the
+ * one of the first granule, so a call may transition fewer granules than
+ * requested, which also bounds the time spent in a single call. The caller is
+ * expected to issue another call for the remaining granules.
+ *
  * Parameters
  *   base               Base address of the first granule to transition, aligned
  *                      to granule size.
  *   *granule_count     Pointer to a variable containing the number of granules
  *                      to be transitioned. This value will be overwritten with
  *                      the number of granules actually transitioned once this
- *                      function returns. It is possible to return an error part
- *                      way through the process and have a non-zero number of
- *                      granules transitioned. TODO is this acceptable?
+ *                      function returns. An error is only returned if no
+ *                      granule was transitioned, in which case it is 0.
  *   target_gpi         GPI to transition the granules to.
  *   src_sec_state      Security state of the requesting entity. This will be
  *                      combined with target_gpi to determine whether a
@@ -1841,6 +1923,8 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 		       uint8_t target_gpi, uint8_t src_sec_state)
 {
 	gpi_info_t gpi_info = { 0, NULL, 0, 0, 0 };
+	size_t gran_size = GPT_PGS_ACTUAL_SIZE(gpt_config.p);
+	unsigned int cnt;
 	int res;
 	size_t size;
 
@@ -1850,14 +1934,16 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 	/* Ensure that MMU and caches are enabled */
 	assert((read_sctlr_el3() & SCTLR_C_BIT) != 0UL);
 
-	/* Only one granule supported per call at this point. */
-	if ((*granule_count) != 1U) {
-		VERBOSE("GPT: Invalid granule count! Only one allowed per transition request.\n");
+	if (((*granule_count) == 0U) ||
+	    ((*granule_count) > (ULONG_MAX / gran_size))) {
+		VERBOSE("GPT: Invalid granule count: %" PRIu64 "\n",
+			*granule_count);
+		*granule_count = 0U;
 		return -EINVAL;
 	}
 
 	/* Calculate total region size and zero out granule count. */
-	size = *granule_count * GPT_PGS_ACTUAL_SIZE(gpt_config.p);
+	size = *granule_count * gran_size;
 	*granule_count = 0U;
 
 	/* Make sure target GPI is valid. */
@@ -1876,9 +1962,7 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 	}
 
 	/* Make sure base and size are valid */
-	if (((base & (GPT_PGS_ACTUAL_SIZE(gpt_config.p) - 1UL)) != 0UL) ||
-	    ((size & (GPT_PGS_ACTUAL_SIZE(gpt_config.p) - 1UL)) != 0UL) ||
-	    (size == 0UL) ||
+	if (((base & (gran_size - 1UL)) != 0UL) ||
 	    ((base + size) >= GPT_PPS_ACTUAL_SIZE(gpt_config.t))) {
 		VERBOSE("GPT: Invalid granule transition address range!\n");
 		VERBOSE("      Base=0x%" PRIx64 "\n", base);
@@ -1886,7 +1970,11 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 		return -EINVAL;
 	}
 
-	/* Get GPI info for next granule to transition. */
+	/* Limit this batch to the 2MB block containing the first granule. */
+	cnt = (unsigned int)((MIN(base + size, ALIGN_2MB(base) + SZ_2M) - base) /
+			     gran_size);
+
+	/* Get GPI info for first granule to transition. */
 	res = get_gpi_params(base, &gpi_info);
 	if (res != 0) {
 		return res;
@@ -1914,16 +2002,22 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 	}
 #endif
 
+	/*
+	 * The granules of the batch must all be in the same state, so that the
+	 * check above and the cache maintenance apply to all of them.
+	 */
+	cnt = count_same_gpi(base, cnt, &gpi_info);
+
 	if (((target_gpi == GPT_GPI_NS) && (gpi_info.gpi == GPT_GPI_NSO)) ||
 	    ((target_gpi == GPT_GPI_NSO) && (gpi_info.gpi == GPT_GPI_NS))) {
 		/* Handle NS/NSO transition. */
-		gpt_write_entry(base, target_gpi, &gpi_info);
+		gpt_write_entries(base, cnt, target_gpi, &gpi_info);
 	} else if ((target_gpi == GPT_GPI_NS) || (target_gpi == GPT_GPI_NSO)) {
 		/* Handle undelegate transition. */
-		gpt_undelegate(base, target_gpi, &gpi_info);
+		gpt_undelegate(base, cnt, target_gpi, &gpi_info);
 	} else {
 		/* Handle delegate transition. */
-		gpt_delegate(base, target_gpi, &gpi_info);
+		gpt_delegate(base, cnt, target_gpi, &gpi_info);
 	}
 
 #if (RME_GPT_MAX_BLOCK != 0)
@@ -1935,8 +2029,8 @@ int gpt_transition_pas(uint64_t base, uint64_t *granule_count,
 
 	GPT_UNLOCK;
 
-	/* Increment granule counter only once everything is complete. */
-	(*granule_count)++;
+	/* Report the number of granules once everything is complete. */
+	*granule_count = cnt;
 
 	return 0;
 }
@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2020-2024, Arm Limited. All rights reserved.
+# Copyright (c) 2020-2026, Arm Limited. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -7,7 +7,15 @@
 include lib/libc/libc_common.mk
 
 ifeq (${ARCH},aarch64)
+LIBC_SRCS	:=	$(filter-out $(addprefix lib/libc/,	\
+			memcmp.c			\
+			memcpy.c			\
+			memmove.c), ${LIBC_SRCS})
+
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch64/,	\
+			memcmp.S			\
+			memcpy.S			\
+			memmove.S			\
 			memset.S)
 else
 LIBC_SRCS	+=	$(addprefix lib/libc/aarch32/,	\
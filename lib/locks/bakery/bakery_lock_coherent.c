@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -40,8 +40,9 @@
 	assert((_entry) < BAKERY_LOCK_MAX_CPUS);	\
 } while (false)
 
-/* Obtain a ticket for a given CPU */
-static unsigned int bakery_get_ticket(bakery_lock_t *bakery, unsigned int me)
+/* Obtain a ticket for a given CPU among the contenders [first, end) */
+static unsigned int bakery_get_ticket(bakery_lock_t *bakery, unsigned int me,
+				      unsigned int first, unsigned int end)
 {
 	unsigned int my_ticket, their_ticket;
 	unsigned int they;
@@ -61,7 +62,7 @@ static unsigned int bakery_get_ticket(bakery_lock_t *bakery, unsigned int me)
 	 */
 	my_ticket = 0U;
 	bakery->lock_data[me] = make_bakery_data(CHOOSING_TICKET, my_ticket);
-	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+	for (they = first; they < end; they++) {
 		their_ticket = bakery_ticket_number(bakery->lock_data[they]);
 		if (their_ticket > my_ticket) {
 			my_ticket = their_ticket;
@@ -83,32 +84,38 @@ static unsigned int bakery_get_ticket(bakery_lock_t *bakery, unsigned int me)
  * Acquire bakery lock
  *
  * Contending CPUs need first obtain a non-zero ticket and then calculate
- * priority value. A contending CPU iterate over all other CPUs in the platform,
- * which may be contending for the same lock, in the order of their ordinal
- * position (CPU0, CPU1 and so on). A non-contending CPU will have its ticket
- * (and priority) value as 0. The contending CPU compares its priority with that
- * of others'. The CPU with the highest priority (lowest numerical value)
- * acquires the lock
+ * priority value. A contending CPU iterate over all other CPUs which may be
+ * contending for the same lock, i.e. the 'cpu_count' CPUs starting at core
+ * position 'first_cpu', in the order of their ordinal position (CPU0, CPU1 and
+ * so on). A non-contending CPU will have its ticket (and priority) value as 0.
+ * The contending CPU compares its priority with that of others'. The CPU with
+ * the highest priority (lowest numerical value) acquires the lock.
+ *
+ * All the CPUs that take the lock must pass the same range.
  */
-void bakery_lock_get(bakery_lock_t *bakery)
+void bakery_lock_get_range(bakery_lock_t *bakery, unsigned int first_cpu,
+			   unsigned int cpu_count)
 {
-	unsigned int they, me;
+	unsigned int they, me, end;
 	unsigned int my_ticket, my_prio, their_ticket;
 	unsigned int their_bakery_data;
 
 	me = plat_my_core_pos();
+	end = first_cpu + cpu_count;
 
 	assert_bakery_entry_valid(me, bakery);
+	assert((me >= first_cpu) && (me < end) &&
+	       (end <= BAKERY_LOCK_MAX_CPUS));
 
 	/* Get a ticket */
-	my_ticket = bakery_get_ticket(bakery, me);
+	my_ticket = bakery_get_ticket(bakery, me, first_cpu, end);
 
 	/*
 	 * Now that we got our ticket, compute our priority value, then compare
 	 * with that of others, and proceed to acquire the lock
 	 */
 	my_prio = bakery_get_priority(my_ticket, me);
-	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+	for (they = first_cpu; they < end; they++) {
 		if (me == they) {
 			continue;
 		}
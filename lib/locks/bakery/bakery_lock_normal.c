@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2020, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -99,7 +99,8 @@ static inline __unused bool is_lock_acquired(const bakery_info_t *my_bakery_info
 }
 
 static unsigned int bakery_get_ticket(bakery_lock_t *lock,
-				      unsigned int me, bool is_cached)
+				      unsigned int me, unsigned int first,
+				      unsigned int end, bool is_cached)
 {
 	unsigned int my_ticket, their_ticket;
 	unsigned int they;
@@ -128,7 +129,7 @@ static unsigned int bakery_get_ticket(bakery_lock_t *lock,
 	 * Iterate through the bakery information of each contender to allocate
 	 * the highest ticket number for this cpu.
 	 */
-	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+	for (they = first; they < end; they++) {
 		if (me == they)
 			continue;
 
@@ -162,26 +163,37 @@ static unsigned int bakery_get_ticket(bakery_lock_t *lock,
 	return my_ticket;
 }
 
-void bakery_lock_get(bakery_lock_t *lock)
+/*
+ * Acquire a bakery lock only contended for by the 'cpu_count' CPUs starting at
+ * core position 'first_cpu'. Only their bakery information is scanned, which
+ * includes the cache maintenance of an entry per CPU when the data cache is
+ * off. All the CPUs that take the lock must pass the same range.
+ */
+void bakery_lock_get_range(bakery_lock_t *lock, unsigned int first_cpu,
+			   unsigned int cpu_count)
 {
-	unsigned int they, me;
+	unsigned int they, me, end;
 	unsigned int my_ticket, my_prio, their_ticket;
 	bakery_info_t *their_bakery_info;
 	unsigned int their_bakery_data;
 	bool is_cached;
 
 	me = plat_my_core_pos();
+	end = first_cpu + cpu_count;
 	is_cached = is_dcache_enabled();
 
+	assert((me >= first_cpu) && (me < end) &&
+	       (end <= BAKERY_LOCK_MAX_CPUS));
+
 	/* Get a ticket */
-	my_ticket = bakery_get_ticket(lock, me, is_cached);
+	my_ticket = bakery_get_ticket(lock, me, first_cpu, end, is_cached);
 
 	/*
 	 * Now that we got our ticket, compute our priority value, then compare
 	 * with that of others, and proceed to acquire the lock
 	 */
 	my_prio = bakery_get_priority(my_ticket, me);
-	for (they = 0U; they < BAKERY_LOCK_MAX_CPUS; they++) {
+	for (they = first_cpu; they < end; they++) {
 		if (me == they)
 			continue;
 
@@ -0,0 +1,513 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <common/debug.h>
+#include <lib/utils.h>
+#include <lib/utils_def.h>
+#include <tf_lz4.h>
+
+/*
+ * Decoder for the LZ4 frame format, as produced by the lz4 command line tool.
+ * See lz4_Frame_format.md and lz4_Block_format.md in the LZ4 sources.
+ *
+ * The compressed data can be passed in chunks of any size. The decompressed
+ * data is written straight to the output buffer, which also holds the history
+ * that matches refer to, so no workspace is needed. Checksums are skipped: the
+ * compressed image is expected to be authenticated instead.
+ */
+
+#define LZ4_FRAME_MAGIC			U(0x184D2204)
+
+#define LZ4_FLG_VERSION_MASK		U(0xC0)
+#define LZ4_FLG_VERSION			U(0x40)
+#define LZ4_FLG_BLOCK_CHECKSUM		U(0x10)
+#define LZ4_FLG_CONTENT_SIZE		U(0x08)
+#define LZ4_FLG_CONTENT_CHECKSUM	U(0x04)
+#define LZ4_FLG_RESERVED		U(0x02)
+#define LZ4_FLG_DICT_ID			U(0x01)
+
+#define LZ4_BD_BLOCK_MAX_MASK		U(0x70)
+#define LZ4_BD_BLOCK_MAX_SHIFT		4
+#define LZ4_BD_RESERVED			U(0x8F)
+
+#define LZ4_BLOCK_UNCOMPRESSED		U(0x80000000)
+#define LZ4_CHECKSUM_SIZE		4U
+
+#define LZ4_RUN_MASK			U(0xF)
+#define LZ4_MIN_MATCH			4U
+
+enum lz4_state {
+	/* Frame header and block headers */
+	LZ4_MAGIC,
+	LZ4_FLG_BD,
+	LZ4_CONTENT_SIZE,
+	LZ4_HC,
+	LZ4_BLOCK_SIZE,
+	LZ4_SKIP,
+	LZ4_RAW_BLOCK,
+	/* Sequences of a compressed block */
+	LZ4_TOKEN,
+	LZ4_LIT_LEN,
+	LZ4_LITERALS,
+	LZ4_OFFSET,
+	LZ4_MATCH_LEN,
+};
+
+static struct {
+	enum lz4_state state;
+	/* Fixed-size fields being collected, possibly across chunks */
+	uint8_t field[8];
+	unsigned int field_len;
+	unsigned int field_size;
+	/* Frame being decoded */
+	uint8_t flags;
+	size_t block_max;
+	bool has_content_size;
+	uint64_t content_size;
+	bool in_frame;
+	uint8_t *frame_start;
+	unsigned int frames;
+	/* Block being decoded */
+	size_t block_left;
+	size_t skip_len;
+	/* Sequence being decoded */
+	size_t lit_len;
+	size_t match_len;
+	size_t offset;
+	/* Output buffer */
+	uint8_t *out_start;
+	uint8_t *out;
+	uint8_t *out_end;
+} lz4;
+
+static int lz4_error(const char *msg)
+{
+	ERROR("lz4: %s\n", msg);
+	return -EIO;
+}
+
+static uint32_t lz4_read_le32(const uint8_t *p)
+{
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+	       ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void lz4_expect(enum lz4_state state, unsigned int field_size)
+{
+	lz4.state = state;
+	lz4.field_len = 0U;
+	lz4.field_size = field_size;
+}
+
+/*
+ * Copy input bytes to the field being collected. Return true once the field
+ * is complete.
+ */
+static bool lz4_collect(const uint8_t **in, const uint8_t *in_end)
+{
+	size_t len = MIN((size_t)(in_end - *in),
+			 (size_t)(lz4.field_size - lz4.field_len));
+
+	(void)memcpy(&lz4.field[lz4.field_len], *in, len);
+	lz4.field_len += (unsigned int)len;
+	*in += len;
+
+	return lz4.field_len == lz4.field_size;
+}
+
+static void lz4_skip(size_t len)
+{
+	lz4.skip_len = len;
+	lz4.state = LZ4_SKIP;
+}
+
+static void lz4_block_end(void)
+{
+	if ((lz4.flags & LZ4_FLG_BLOCK_CHECKSUM) != 0U) {
+		lz4_skip(LZ4_CHECKSUM_SIZE);
+	} else {
+		lz4_expect(LZ4_BLOCK_SIZE, 4U);
+	}
+}
+
+static int lz4_parse_flg_bd(void)
+{
+	uint8_t flg = lz4.field[0];
+	uint8_t bd = lz4.field[1];
+	unsigned int block_max_id;
+
+	if ((flg & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) {
+		return lz4_error("unsupported frame version");
+	}
+
+	if ((flg & (LZ4_FLG_RESERVED | LZ4_FLG_DICT_ID)) != 0U) {
+		return lz4_error("unsupported frame flags");
+	}
+
+	block_max_id = (bd & LZ4_BD_BLOCK_MAX_MASK) >> LZ4_BD_BLOCK_MAX_SHIFT;
+	if (((bd & LZ4_BD_RESERVED) != 0U) || (block_max_id < 4U)) {
+		return lz4_error("invalid block descriptor");
+	}
+
+	lz4.flags = flg;
+	lz4.block_max = (size_t)1U << (8U + (2U * block_max_id));
+	lz4.has_content_size = (flg & LZ4_FLG_CONTENT_SIZE) != 0U;
+
+	if (lz4.has_content_size) {
+		lz4_expect(LZ4_CONTENT_SIZE, 8U);
+	} else {
+		lz4_expect(LZ4_HC, 1U);
+	}
+
+	return 0;
+}
+
+static int lz4_parse_block_size(void)
+{
+	uint32_t block_size = lz4_read_le32(lz4.field);
+
+	if (block_size == 0U) {
+		/* EndMark */
+		if (lz4.has_content_size &&
+		    ((uint64_t)(lz4.out - lz4.frame_start) !=
+		     lz4.content_size)) {
+			return lz4_error("content size mismatch");
+		}
+
+		lz4.in_frame = false;
+		lz4.frames++;
+
+		if ((lz4.flags & LZ4_FLG_CONTENT_CHECKSUM) != 0U) {
+			lz4_skip(LZ4_CHECKSUM_SIZE);
+		} else {
+			lz4_expect(LZ4_MAGIC, 4U);
+		}
+
+		return 0;
+	}
+
+	lz4.block_left = block_size & ~LZ4_BLOCK_UNCOMPRESSED;
+	if ((lz4.block_left == 0U) || (lz4.block_left > lz4.block_max)) {
+		return lz4_error("invalid block size");
+	}
+
+	if ((block_size & LZ4_BLOCK_UNCOMPRESSED) != 0U) {
+		lz4.state = LZ4_RAW_BLOCK;
+	} else {
+		lz4.state = LZ4_TOKEN;
+	}
+
+	return 0;
+}
+
+/* Called once all the literals of a sequence have been copied */
+static void lz4_literals_done(void)
+{
+	if (lz4.block_left == 0U) {
+		/* The last sequence of a block only has literals */
+		lz4_block_end();
+	} else {
+		lz4_expect(LZ4_OFFSET, 2U);
+	}
+}
+
+static int lz4_copy_match(void)
+{
+	size_t len = lz4.match_len + LZ4_MIN_MATCH;
+	const uint8_t *src = lz4.out - lz4.offset;
+	size_t i;
+
+	if (len > (size_t)(lz4.out_end - lz4.out)) {
+		return lz4_error("output buffer too small");
+	}
+
+	if (lz4.offset >= len) {
+		(void)memcpy(lz4.out, src, len);
+	} else {
+		/* Overlapping match, which repeats the last bytes */
+		for (i = 0U; i < len; i++) {
+			lz4.out[i] = src[i];
+		}
+	}
+
+	lz4.out += len;
+
+	if (lz4.block_left == 0U) {
+		lz4_block_end();
+	} else {
+		lz4.state = LZ4_TOKEN;
+	}
+
+	return 0;
+}
+
+/*
+ * Decode the compressed block data available in [in, in_end), which the
+ * caller has limited to the current block.
+ */
+static int lz4_decode_sequences(const uint8_t **in, const uint8_t *in_end)
+{
+	size_t len;
+	uint8_t byte;
+
+	switch (lz4.state) {
+	case LZ4_TOKEN:
+		byte = *(*in)++;
+		lz4.lit_len = byte >> 4;
+		lz4.match_len = byte & LZ4_RUN_MASK;
+
+		if (lz4.lit_len == LZ4_RUN_MASK) {
+			lz4.state = LZ4_LIT_LEN;
+		} else if (lz4.lit_len != 0U) {
+			lz4.state = LZ4_LITERALS;
+		} else {
+			lz4.block_left--;
+			lz4_literals_done();
+			return 0;
+		}
+		break;
+
+	case LZ4_LIT_LEN:
+		byte = *(*in)++;
+		lz4.lit_len += byte;
+		if (byte != UINT8_MAX) {
+			lz4.state = LZ4_LITERALS;
+		}
+		break;
+
+	case LZ4_LITERALS:
+		if (lz4.lit_len > (size_t)(lz4.out_end - lz4.out)) {
+			return lz4_error("output buffer too small");
+		}
+
+		len = MIN((size_t)(in_end - *in), lz4.lit_len);
+		(void)memcpy(lz4.out, *in, len);
+		lz4.out += len;
+		*in += len;
+		lz4.lit_len -= len;
+		lz4.block_left -= len;
+
+		if (lz4.lit_len == 0U) {
+			lz4_literals_done();
+		}
+		return 0;
+
+	case LZ4_OFFSET:
+		len = lz4.field_len;
+		if (!lz4_collect(in, in_end)) {
+			lz4.block_left -= lz4.field_len - len;
+			return 0;
+		}
+		lz4.block_left -= lz4.field_len - len;
+
+		lz4.offset = (size_t)lz4.field[0] | ((size_t)lz4.field[1] << 8);
+		if ((lz4.offset == 0U) ||
+		    (lz4.offset > (size_t)(lz4.out - lz4.out_start))) {
+			return lz4_error("invalid match offset");
+		}
+
+		if (lz4.match_len == LZ4_RUN_MASK) {
+			lz4.state = LZ4_MATCH_LEN;
+			return 0;
+		}
+		return lz4_copy_match();
+
+	case LZ4_MATCH_LEN:
+		byte = *(*in)++;
+		lz4.match_len += byte;
+		lz4.block_left--;
+		if (byte != UINT8_MAX) {
+			return lz4_copy_match();
+		}
+		return 0;
+
+	default:
+		return lz4_error("invalid state");
+	}
+
+	/* One byte of the block has been consumed */
+	lz4.block_left--;
+
+	/* Lengths cannot grow past the output buffer */
+	if ((lz4.lit_len > (size_t)(lz4.out_end - lz4.out)) ||
+	    (lz4.match_len > (size_t)(lz4.out_end - lz4.out))) {
+		return lz4_error("output buffer too small");
+	}
+
+	return 0;
+}
+
+/*
+ * lz4_stream_start - start decompressing LZ4 frames
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused)
+ * @work_len: length of workspace
+ */
+int lz4_stream_start(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		     size_t work_len)
+{
+	zeromem(&lz4, sizeof(lz4));
+
+	lz4.out_start = (uint8_t *)out_buf;
+	lz4.out = lz4.out_start;
+	lz4.out_end = lz4.out_start + out_len;
+
+	lz4_expect(LZ4_MAGIC, 4U);
+
+	return 0;
+}
+
+/*
+ * lz4_stream_update - decompress the next chunk of compressed data
+ * @in_buf: chunk of compressed input
+ * @in_len: length of in_buf
+ */
+int lz4_stream_update(uintptr_t in_buf, size_t in_len)
+{
+	const uint8_t *in = (const uint8_t *)in_buf;
+	const uint8_t *in_end = in + in_len;
+	size_t len;
+	int ret = 0;
+
+	while ((in < in_end) && (ret == 0)) {
+		switch (lz4.state) {
+		case LZ4_MAGIC:
+			if (lz4_collect(&in, in_end)) {
+				if (lz4_read_le32(lz4.field) != LZ4_FRAME_MAGIC) {
+					return lz4_error("bad frame magic");
+				}
+				lz4_expect(LZ4_FLG_BD, 2U);
+			}
+			break;
+
+		case LZ4_FLG_BD:
+			if (lz4_collect(&in, in_end)) {
+				ret = lz4_parse_flg_bd();
+			}
+			break;
+
+		case LZ4_CONTENT_SIZE:
+			if (lz4_collect(&in, in_end)) {
+				lz4.content_size =
+					(uint64_t)lz4_read_le32(lz4.field) |
+					((uint64_t)lz4_read_le32(&lz4.field[4])
+					 << 32);
+				lz4_expect(LZ4_HC, 1U);
+			}
+			break;
+
+		case LZ4_HC:
+			/* The header checksum is not verified */
+			if (lz4_collect(&in, in_end)) {
+				lz4.in_frame = true;
+				lz4.frame_start = lz4.out;
+				lz4_expect(LZ4_BLOCK_SIZE, 4U);
+			}
+			break;
+
+		case LZ4_BLOCK_SIZE:
+			if (lz4_collect(&in, in_end)) {
+				ret = lz4_parse_block_size();
+			}
+			break;
+
+		case LZ4_SKIP:
+			len = MIN((size_t)(in_end - in), lz4.skip_len);
+			in += len;
+			lz4.skip_len -= len;
+			if (lz4.skip_len == 0U) {
+				/* Checksums end either a block or a frame */
+				if (lz4.in_frame) {
+					lz4_expect(LZ4_BLOCK_SIZE, 4U);
+				} else {
+					lz4_expect(LZ4_MAGIC, 4U);
+				}
+			}
+			break;
+
+		case LZ4_RAW_BLOCK:
+			len = MIN((size_t)(in_end - in), lz4.block_left);
+			if (len > (size_t)(lz4.out_end - lz4.out)) {
+				return lz4_error("output buffer too small");
+			}
+
+			(void)memcpy(lz4.out, in, len);
+			lz4.out += len;
+			in += len;
+			lz4.block_left -= len;
+
+			if (lz4.block_left == 0U) {
+				lz4_block_end();
+			}
+			break;
+
+		default:
+			if (lz4.block_left == 0U) {
+				return lz4_error("truncated block");
+			}
+
+			len = MIN((size_t)(in_end - in), lz4.block_left);
+			ret = lz4_decode_sequences(&in, in + len);
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/*
+ * lz4_stream_finish - check that the compressed data is complete
+ * @out_buf: upon exit, the end of output
+ */
+int lz4_stream_finish(uintptr_t *out_buf)
+{
+	if ((lz4.state != LZ4_MAGIC) || (lz4.field_len != 0U) ||
+	    (lz4.frames == 0U)) {
+		return lz4_error("truncated input");
+	}
+
+	VERBOSE("lz4: %lu byte output\n",
+		(unsigned long)(lz4.out - lz4.out_start));
+
+	*out_buf = (uintptr_t)lz4.out;
+
+	return 0;
+}
+
+/*
+ * lz4_decompress - decompress LZ4 frames
+ * @in_buf: source of compressed input. Upon exit, the end of input.
+ * @in_len: length of in_buf
+ * @out_buf: destination of decompressed output. Upon exit, the end of output.
+ * @out_len: length of out_buf
+ * @work_buf: workspace (unused)
+ * @work_len: length of workspace
+ */
+int lz4_decompress(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
+		   size_t out_len, uintptr_t work_buf, size_t work_len)
+{
+	int ret;
+
+	ret = lz4_stream_start(*out_buf, out_len, work_buf, work_len);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = lz4_stream_update(*in_buf, in_len);
+	if (ret != 0) {
+		return ret;
+	}
+
+	*in_buf += in_len;
+
+	return lz4_stream_finish(out_buf);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2024, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -25,6 +25,9 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 {
 	int rc;
 	unsigned long long ts_value;
+#if ENABLE_SMC_LATENCY_HIST
+	uint32_t count = 0U;
+#endif
 
 	/* Determine if the cpu exists of not */
 	if (!is_valid_mpidr(x2))
@@ -53,6 +56,20 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		if (smc_fid == PMF_SMC_GET_VERSION_32) {
 			SMC_RET2(handle, SMC_OK, PMF_SMC_VERSION);
 		}
+
+#if ENABLE_SMC_LATENCY_HIST
+		if (smc_fid == PMF_SMC_GET_SMC_HIST_32) {
+			/*
+			 * Return error code and the number of SMCs in the
+			 * histogram bucket to the caller.
+			 * x0 --> error code.
+			 * x1 --> SMC count.
+			 */
+			rc = pmf_smc_hist_get((uint32_t)x1, x2,
+					(unsigned int)x3, &count);
+			SMC_RET2(handle, rc, count);
+		}
+#endif
 	} else {
 		if (smc_fid == PMF_SMC_GET_TIMESTAMP_64 ||
 		    smc_fid == PMF_SMC_GET_TIMESTAMP_64_DEP) {
@@ -70,6 +87,20 @@ uintptr_t pmf_smc_handler(unsigned int smc_fid,
 		if (smc_fid == PMF_SMC_GET_VERSION_64) {
 			SMC_RET2(handle, SMC_OK, PMF_SMC_VERSION);
 		}
+
+#if ENABLE_SMC_LATENCY_HIST
+		if (smc_fid == PMF_SMC_GET_SMC_HIST_64) {
+			/*
+			 * Return error code and the number of SMCs in the
+			 * histogram bucket to the caller.
+			 * x0 --> error code.
+			 * x1 --> SMC count.
+			 */
+			rc = pmf_smc_hist_get((uint32_t)x1, x2,
+					(unsigned int)x3, &count);
+			SMC_RET2(handle, rc, count);
+		}
+#endif
 	}
 
 	WARN("Unimplemented PMF Call: 0x%x \n", smc_fid);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+
+#include <arch_helpers.h>
+#include <lib/per_cpu/per_cpu.h>
+#include <lib/pmf/pmf.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+
+/*
+ * Latency histograms of the SMCs handled by each CPU. A CPU only ever updates
+ * its own histograms so no lock is needed. Other CPUs may read them at any
+ * time, which at worst returns a count missing the SMC in flight.
+ */
+static PER_CPU_DEFINE(pmf_smc_hist_t, smc_hist);
+
+/*
+ * SMC being handled by each CPU. It is kept in memory rather than on the stack
+ * so that an SMC that powers the CPU down, like a CPU_SUSPEND to a power down
+ * state, can be accounted for once the CPU resumes through the warm boot path.
+ */
+typedef struct pmf_smc_hist_inflight {
+	uint64_t start;
+	uint32_t smc_fid;
+	bool active;
+} pmf_smc_hist_inflight_t;
+
+static PER_CPU_DEFINE(pmf_smc_hist_inflight_t, smc_hist_inflight);
+
+/* Return the histogram bucket for a latency */
+static unsigned int pmf_smc_hist_bucket(uint64_t ticks)
+{
+	unsigned int bucket;
+
+	if (ticks == 0ULL) {
+		return 0U;
+	}
+
+	bucket = 64U - (unsigned int)__builtin_clzll(ticks);
+
+	return MIN(bucket, PMF_SMC_HIST_BUCKETS - 1U);
+}
+
+/*
+ * Record that the current CPU handled an SMC in 'ticks' ticks of the generic
+ * counter.
+ */
+void pmf_smc_hist_record(uint32_t smc_fid, uint64_t ticks)
+{
+	pmf_smc_hist_t *hist = PER_CPU_CUR(smc_hist);
+	pmf_smc_hist_entry_t *entry = NULL;
+	unsigned int i;
+
+	for (i = 0U; i < hist->num_entries; i++) {
+		if (hist->entries[i].smc_fid == smc_fid) {
+			entry = &hist->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		if (hist->num_entries == PMF_SMC_HIST_MAX_FIDS) {
+			hist->dropped++;
+			return;
+		}
+
+		/*
+		 * Publish the new entry only once it is set up, readers only
+		 * look at the first 'num_entries' entries.
+		 */
+		entry = &hist->entries[hist->num_entries];
+		entry->smc_fid = smc_fid;
+		dmbish();
+		hist->num_entries++;
+	}
+
+	entry->count[pmf_smc_hist_bucket(ticks)]++;
+}
+
+/* Record the start of the handling of an SMC by the current CPU */
+void pmf_smc_hist_start(uint32_t smc_fid)
+{
+	pmf_smc_hist_inflight_t *inflight = PER_CPU_CUR(smc_hist_inflight);
+
+	inflight->smc_fid = smc_fid;
+	inflight->start = read_cntpct_el0();
+	inflight->active = true;
+}
+
+/*
+ * Record the latency of the SMC handled by the current CPU, if any, now that it
+ * returns to its caller.
+ */
+void pmf_smc_hist_end(void)
+{
+	pmf_smc_hist_inflight_t *inflight = PER_CPU_CUR(smc_hist_inflight);
+
+	if (!inflight->active) {
+		return;
+	}
+
+	inflight->active = false;
+	pmf_smc_hist_record(inflight->smc_fid,
+			    read_cntpct_el0() - inflight->start);
+}
+
+/*
+ * Retrieve the number of SMCs with function ID 'smc_fid' handled by the CPU
+ * 'mpidr' whose latency falls in histogram bucket 'bucket'.
+ */
+int pmf_smc_hist_get(uint32_t smc_fid, u_register_t mpidr,
+		unsigned int bucket, uint32_t *count)
+{
+	const pmf_smc_hist_t *hist;
+	unsigned int num_entries, i;
+	int cpu_idx;
+
+	assert(count != NULL);
+
+	cpu_idx = plat_core_pos_by_mpidr(mpidr);
+	if ((cpu_idx < 0) || (bucket >= PMF_SMC_HIST_BUCKETS)) {
+		return -EINVAL;
+	}
+
+	hist = pmf_smc_hist_by_index((unsigned int)cpu_idx);
+	num_entries = hist->num_entries;
+	dmbish();
+
+	for (i = 0U; i < num_entries; i++) {
+		if (hist->entries[i].smc_fid == smc_fid) {
+			*count = hist->entries[i].count[bucket];
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Return the latency histograms of a CPU */
+const pmf_smc_hist_t *pmf_smc_hist_by_index(unsigned int cpu_idx)
+{
+	assert(cpu_idx < PLATFORM_CORE_COUNT);
+
+	return PER_CPU_BY_INDEX(smc_hist, cpu_idx);
+}
@@ -1064,6 +1064,9 @@ void psci_warmboot_entrypoint(unsigned int cpu_idx)
 	unsigned int end_pwrlvl;
 	unsigned int parent_nodes[PLAT_MAX_PWR_LVL] = {0};
 	psci_power_state_t state_info = { {PSCI_LOCAL_STATE_RUN} };
+#if ENABLE_SMC_LATENCY_HIST
+	bool resumed = false;
+#endif
 
 	/*
 	 * Verify that we have been explicitly turned ON or resumed from
@@ -1113,6 +1116,10 @@ void psci_warmboot_entrypoint(unsigned int cpu_idx)
 	} else {
 		unsigned int max_off_lvl = psci_find_max_off_lvl(&state_info);
 
+#if ENABLE_SMC_LATENCY_HIST
+		resumed = true;
+#endif
+
 		assert(max_off_lvl != PSCI_INVALID_PWR_LVL);
 		psci_cpu_suspend_to_powerdown_finish(cpu_idx, max_off_lvl, &state_info, false);
 	}
@@ -1146,6 +1153,18 @@ void psci_warmboot_entrypoint(unsigned int cpu_idx)
 	 * in the reverse order to which they were acquired.
 	 */
 	psci_release_pwr_domain_locks(end_pwrlvl, parent_nodes);
+
+#if ENABLE_SMC_LATENCY_HIST
+	/*
+	 * A CPU resuming from a power down suspend state returns from its
+	 * CPU_SUSPEND here rather than through the SMC handler, so record the
+	 * latency of that SMC now. A CPU that has just been turned on has no
+	 * SMC to return from, its last one was CPU_OFF.
+	 */
+	if (resumed) {
+		pmf_smc_hist_end();
+	}
+#endif
 }
 
 /*******************************************************************************
@@ -11,6 +11,7 @@
 #include <arch_features.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <lib/cassert.h>
 #include <lib/pmf/pmf.h>
 #include <lib/runtime_instr.h>
 #include <lib/smccc.h>
@@ -50,6 +51,82 @@ int psci_cpu_on(u_register_t target_cpu,
 	return psci_cpu_on_start(target_cpu);
 }
 
+#if PSCI_BULK_CPU_ON
+/*
+ * Number of Aff0 values that the mask of a bulk CPU_ON can select. A cluster
+ * cannot have more CPUs than the platform, and the mask only has 64 bits.
+ */
+#ifndef PLAT_PSCI_BULK_MAX_AFF0
+#if PLATFORM_CORE_COUNT < 64
+#define PLAT_PSCI_BULK_MAX_AFF0	PLATFORM_CORE_COUNT
+#else
+#define PLAT_PSCI_BULK_MAX_AFF0	U(64)
+#endif
+#endif
+
+CASSERT((PLAT_PSCI_BULK_MAX_AFF0 > 0U) && (PLAT_PSCI_BULK_MAX_AFF0 <= 64U),
+	assert_psci_bulk_max_aff0_out_of_range);
+
+/*******************************************************************************
+ * Turn on the CPUs whose MPIDR is 'target_aff' with Aff0 set to the position of
+ * any bit set in 'aff0_mask'. This is equivalent to a CPU_ON for each of them
+ * with the same entrypoint and context id, except that the entrypoint is only
+ * validated once and the power on requests are issued back-to-back. The mask
+ * of the CPUs successfully requested to turn on is returned in 'on_mask', and
+ * the error code of the first CPU which could not be is returned, if any. The
+ * mask cannot select Aff0 values of PLAT_PSCI_BULK_MAX_AFF0 or more.
+ ******************************************************************************/
+int psci_cpu_on_bulk(u_register_t target_aff, u_register_t aff0_mask,
+		     uintptr_t entrypoint, u_register_t context_id,
+		     u_register_t *on_mask)
+{
+	int rc, ret = PSCI_E_SUCCESS;
+	entry_point_info_t ep = {0};
+	unsigned int aff0, target_idx;
+	u_register_t target_cpu;
+
+	*on_mask = 0U;
+
+	if (((target_aff & (MPIDR_AFFLVL_MASK << MPIDR_AFF0_SHIFT)) != 0U) ||
+	    (aff0_mask == 0U)) {
+		return PSCI_E_INVALID_PARAMS;
+	}
+
+	/* Split in two shifts to stay below 64 when all the bits are valid */
+	if (((aff0_mask >> (PLAT_PSCI_BULK_MAX_AFF0 - 1U)) >> 1U) != 0U) {
+		return PSCI_E_INVALID_PARAMS;
+	}
+
+	rc = psci_validate_entry_point(&ep, entrypoint, context_id);
+	if (rc != PSCI_E_SUCCESS) {
+		return rc;
+	}
+
+	for (aff0 = 0U; aff0 < PLAT_PSCI_BULK_MAX_AFF0; aff0++) {
+		if ((aff0_mask & (1ULL << aff0)) == 0U) {
+			continue;
+		}
+
+		target_cpu = target_aff | ((u_register_t)aff0 << MPIDR_AFF0_SHIFT);
+		if (!is_valid_mpidr(target_cpu)) {
+			rc = PSCI_E_INVALID_PARAMS;
+		} else {
+			target_idx = (unsigned int)plat_core_pos_by_mpidr(target_cpu);
+			*get_cpu_data_by_index(target_idx, warmboot_ep_info) = ep;
+			rc = psci_cpu_on_start(target_cpu);
+		}
+
+		if (rc == PSCI_E_SUCCESS) {
+			*on_mask |= 1ULL << aff0;
+		} else if (ret == PSCI_E_SUCCESS) {
+			ret = rc;
+		}
+	}
+
+	return ret;
+}
+#endif /* PSCI_BULK_CPU_ON */
+
 unsigned int psci_version(void)
 {
 	return PSCI_MAJOR_VER | PSCI_MINOR_VER;
@@ -81,6 +158,15 @@ int psci_cpu_suspend(unsigned int power_state,
 	assert(psci_validate_suspend_req(&state_info, is_power_down_state)
 			== PSCI_E_SUCCESS);
 
+#if PSCI_IDLE_GOVERNOR
+	/*
+	 * Avoid entering states of the higher power levels which the recent
+	 * idle residencies of this CPU show are unlikely to pay off. This only
+	 * makes the request shallower so it remains valid.
+	 */
+	psci_stats_demote_suspend_req(cpu_idx, &state_info);
+#endif
+
 	target_pwrlvl = psci_find_target_suspend_lvl(&state_info);
 	if (target_pwrlvl == PSCI_INVALID_PWR_LVL) {
 		ERROR("Invalid target power level for suspend operation\n");
@@ -11,6 +11,7 @@
 #include <arch.h>
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <common/tf_log_deferred.h>
 #include <drivers/arm/gic.h>
 #include <lib/el3_runtime/pubsub_events.h>
 #include <lib/pmf/pmf.h>
@@ -82,6 +83,9 @@ int psci_do_cpu_off(unsigned int end_pwrlvl)
 	 */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
+	/* Print the deferred log of this CPU before it loses its caches */
+	tf_log_deferred_flush_local();
+
 	/*
 	 * This function acquires the lock corresponding to each power
 	 * level so that by the time all locks are taken, the system topology
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2013-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -255,9 +255,15 @@ static inline void psci_dsbish(void)
 	dsbish();
 }
 
+/*
+ * The lock of a power domain node is only taken by the CPUs within it, so only
+ * their bakery tickets need to be scanned.
+ */
 static inline void psci_lock_get(non_cpu_pd_node_t *non_cpu_pd_node)
 {
-	bakery_lock_get(&psci_locks[non_cpu_pd_node->lock_index]);
+	bakery_lock_get_range(&psci_locks[non_cpu_pd_node->lock_index],
+			      non_cpu_pd_node->cpu_start_idx,
+			      non_cpu_pd_node->ncpus);
 }
 
 static inline void psci_lock_release(non_cpu_pd_node_t *non_cpu_pd_node)
@@ -374,6 +380,10 @@ u_register_t psci_stat_residency(u_register_t target_cpu,
 			unsigned int power_state);
 u_register_t psci_stat_count(u_register_t target_cpu,
 			unsigned int power_state);
+#if PSCI_IDLE_GOVERNOR
+void psci_stats_demote_suspend_req(unsigned int cpu_idx,
+			psci_power_state_t *state_info);
+#endif
 
 /* Private exported functions from psci_mem_protect.c */
 u_register_t psci_mem_protect(unsigned int enable);
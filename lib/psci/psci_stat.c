@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -39,6 +39,76 @@ static psci_stat_t psci_cpu_stat[PLATFORM_CORE_COUNT]
 static psci_stat_t psci_non_cpu_stat[PSCI_NUM_NON_CPU_PWR_DOMAINS]
 				[PLAT_MAX_PWR_LVL_STATES];
 
+#if PSCI_IDLE_GOVERNOR
+/*
+ * Predicted idle time of each CPU in microseconds, 0 until a first residency
+ * has been recorded. It is a moving average of the residencies of the CPU in
+ * any low power state, each new one having a weight of
+ * 1 / 2^PSCI_IDLE_PREDICT_SHIFT.
+ */
+#define PSCI_IDLE_PREDICT_SHIFT		3U
+
+static u_register_t psci_cpu_idle_predict[PLATFORM_CORE_COUNT];
+
+static void psci_idle_predict_update(unsigned int cpu_idx,
+				     u_register_t residency)
+{
+	u_register_t predict = psci_cpu_idle_predict[cpu_idx];
+
+	if (predict == 0U) {
+		predict = residency;
+	} else {
+		predict = predict - (predict >> PSCI_IDLE_PREDICT_SHIFT) +
+			  (residency >> PSCI_IDLE_PREDICT_SHIFT);
+	}
+
+	/* Keep 0 to mean that nothing has been recorded yet */
+	psci_cpu_idle_predict[cpu_idx] = (predict == 0U) ? 1U : predict;
+}
+
+/*******************************************************************************
+ * This function is passed the local power states requested by a CPU_SUSPEND
+ * call of the CPU 'cpu_idx'. Starting from the level above the CPU, it finds
+ * the first level whose requested state has a break-even time longer than the
+ * predicted idle time of the CPU, and requests that level and all the levels
+ * above it to stay in the RUN state instead. The state requested for the CPU
+ * itself is left as is.
+ *
+ * Nothing is demoted in OS-initiated mode, in which the OS is in charge of
+ * selecting the state of the higher power levels.
+ ******************************************************************************/
+void psci_stats_demote_suspend_req(unsigned int cpu_idx,
+			psci_power_state_t *state_info)
+{
+	unsigned int lvl;
+	plat_local_state_t local_state;
+	u_register_t predict = psci_cpu_idle_predict[cpu_idx];
+
+	assert(state_info != NULL);
+
+#if PSCI_OS_INIT_MODE
+	if (psci_suspend_mode == OS_INIT)
+		return;
+#endif
+
+	/* No history to base a prediction on yet */
+	if (predict == 0U)
+		return;
+
+	for (lvl = PSCI_CPU_PWR_LVL + 1U; lvl <= PLAT_MAX_PWR_LVL; lvl++) {
+		local_state = state_info->pwr_domain_state[lvl];
+		if (is_local_state_run(local_state) != 0)
+			return;
+
+		if (predict < plat_psci_idle_break_even_time(lvl, local_state))
+			break;
+	}
+
+	for (; lvl <= PLAT_MAX_PWR_LVL; lvl++)
+		state_info->pwr_domain_state[lvl] = PSCI_LOCAL_STATE_RUN;
+}
+#endif /* PSCI_IDLE_GOVERNOR */
+
 /*
  * This functions returns the index into the `psci_stat_t` array given the
  * local power state and power domain level. If the platform implements the
@@ -128,6 +198,10 @@ void psci_stats_update_pwr_up(unsigned int cpu_idx, unsigned int end_pwrlvl,
 	psci_cpu_stat[cpu_idx][stat_idx].residency += residency;
 	psci_cpu_stat[cpu_idx][stat_idx].count++;
 
+#if PSCI_IDLE_GOVERNOR
+	psci_idle_predict_update(cpu_idx, residency);
+#endif
+
 	/*
 	 * Check what power domains above CPU were off
 	 * prior to this CPU powering on.
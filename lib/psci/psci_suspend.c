@@ -11,6 +11,7 @@
 #include <arch_helpers.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <common/tf_log_deferred.h>
 #include <context.h>
 #include <drivers/arm/gic.h>
 #include <lib/el3_runtime/context_mgmt.h>
@@ -129,6 +130,9 @@ int psci_cpu_suspend_start(unsigned int idx,
 	assert((psci_plat_pm_ops->pwr_domain_suspend != NULL) &&
 	       (psci_plat_pm_ops->pwr_domain_suspend_finish != NULL));
 
+	/* Print the deferred log of this CPU while it has nothing else to do */
+	tf_log_deferred_flush_local();
+
 	/* Get the parent nodes */
 	psci_get_parent_pwr_domain_nodes(idx, end_pwrlvl, parent_nodes);
 
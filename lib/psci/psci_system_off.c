@@ -9,6 +9,7 @@
 
 #include <arch_helpers.h>
 #include <common/debug.h>
+#include <common/tf_log_deferred.h>
 #include <drivers/arm/gic.h>
 #include <drivers/console.h>
 #include <plat/common/platform.h>
@@ -42,6 +43,7 @@ void __dead2 psci_system_off(void)
 		psci_spd_pm->svc_system_off();
 	}
 
+	tf_log_deferred_flush();
 	console_flush();
 
 	/* Call the platform specific hook */
@@ -61,6 +63,7 @@ void __dead2 psci_system_reset(void)
 		psci_spd_pm->svc_system_reset();
 	}
 
+	tf_log_deferred_flush();
 	console_flush();
 
 	/* Call the platform specific hook */
@@ -96,6 +99,7 @@ u_register_t psci_system_reset2(uint32_t reset_type, u_register_t cookie)
 	if ((psci_spd_pm != NULL) && (psci_spd_pm->svc_system_reset != NULL)) {
 		psci_spd_pm->svc_system_reset();
 	}
+	tf_log_deferred_flush();
 	console_flush();
 
 	ret = psci_plat_pm_ops->system_reset2((int) is_vendor, reset_type, cookie);
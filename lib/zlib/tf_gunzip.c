@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2018-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <assert.h>
 #include <errno.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include <common/debug.h>
@@ -48,6 +49,32 @@ static void ZLIB_INTERNAL zfree(void *opaque, void *ptr)
 {
 }
 
+static int gunzip_init(z_stream *stream, uintptr_t out_buf, size_t out_len,
+		       uintptr_t work_buf, size_t work_len)
+{
+	int zret;
+
+	zalloc_start = work_buf;
+	zalloc_end = work_buf + work_len;
+	zalloc_current = zalloc_start;
+
+	stream->next_in = Z_NULL;
+	stream->avail_in = 0;
+	stream->next_out = (typeof(stream->next_out))out_buf;
+	stream->avail_out = out_len;
+	stream->zalloc = zcalloc;
+	stream->zfree = zfree;
+	stream->opaque = (voidpf)0;
+
+	zret = inflateInit(stream);
+	if (zret != Z_OK) {
+		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
+		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+	}
+
+	return 0;
+}
+
 /*
  * gunzip - decompress gzip data
  * @in_buf: source of compressed input. Upon exit, the end of input.
@@ -63,23 +90,13 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	z_stream stream;
 	int zret, ret;
 
-	zalloc_start = work_buf;
-	zalloc_end = work_buf + work_len;
-	zalloc_current = zalloc_start;
+	ret = gunzip_init(&stream, *out_buf, out_len, work_buf, work_len);
+	if (ret != 0) {
+		return ret;
+	}
 
 	stream.next_in = (typeof(stream.next_in))*in_buf;
 	stream.avail_in = in_len;
-	stream.next_out = (typeof(stream.next_out))*out_buf;
-	stream.avail_out = out_len;
-	stream.zalloc = zcalloc;
-	stream.zfree = zfree;
-	stream.opaque = (voidpf)0;
-
-	zret = inflateInit(&stream);
-	if (zret != Z_OK) {
-		ERROR("zlib: inflate init failed (ret = %d)\n", zret);
-		return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
-	}
 
 	zret = inflate(&stream, Z_NO_FLUSH);
 	if (zret == Z_STREAM_END) {
@@ -102,6 +119,94 @@ int gunzip(uintptr_t *in_buf, size_t in_len, uintptr_t *out_buf,
 	return ret;
 }
 
+/*
+ * State of the gzip data being decompressed in chunks. inflate() keeps a copy
+ * of the last 32 KB of output in its workspace when called more than once.
+ */
+static z_stream gunzip_stream;
+static bool gunzip_stream_end;
+
+/*
+ * gunzip_stream_start - start decompressing gzip data passed in chunks
+ * @out_buf: destination of decompressed output
+ * @out_len: length of out_buf
+ * @work_buf: workspace
+ * @work_len: length of workspace
+ */
+int gunzip_stream_start(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+			size_t work_len)
+{
+	gunzip_stream_end = false;
+
+	return gunzip_init(&gunzip_stream, out_buf, out_len, work_buf,
+			   work_len);
+}
+
+/*
+ * gunzip_stream_update - decompress the next chunk of gzip data
+ * @in_buf: chunk of compressed input
+ * @in_len: length of in_buf
+ */
+int gunzip_stream_update(uintptr_t in_buf, size_t in_len)
+{
+	int zret;
+
+	/* Anything following the gzip data is ignored, as by gunzip() */
+	if (gunzip_stream_end) {
+		return 0;
+	}
+
+	gunzip_stream.next_in = (typeof(gunzip_stream.next_in))in_buf;
+	gunzip_stream.avail_in = in_len;
+
+	zret = inflate(&gunzip_stream, Z_NO_FLUSH);
+	if (zret == Z_STREAM_END) {
+		gunzip_stream_end = true;
+		return 0;
+	}
+
+	if (zret == Z_OK) {
+		/* All the input is consumed unless the output buffer is full */
+		if (gunzip_stream.avail_in == 0U) {
+			return 0;
+		}
+
+		ERROR("zlib: output buffer too small\n");
+		inflateEnd(&gunzip_stream);
+		return -EIO;
+	}
+
+	if (gunzip_stream.msg)
+		ERROR("%s\n", gunzip_stream.msg);
+	ERROR("zlib: inflate failed (ret = %d)\n", zret);
+	inflateEnd(&gunzip_stream);
+
+	return (zret == Z_MEM_ERROR) ? -ENOMEM : -EIO;
+}
+
+/*
+ * gunzip_stream_finish - check that the gzip data is complete
+ * @out_buf: upon exit, the end of output
+ */
+int gunzip_stream_finish(uintptr_t *out_buf)
+{
+	int ret = 0;
+
+	if (!gunzip_stream_end) {
+		ERROR("zlib: truncated input\n");
+		ret = -EIO;
+	}
+
+	VERBOSE("zlib: %lu byte input\n", gunzip_stream.total_in);
+	VERBOSE("zlib: %lu byte output\n", gunzip_stream.total_out);
+
+	*out_buf = (uintptr_t)gunzip_stream.next_out;
+
+	inflateEnd(&gunzip_stream);
+
+	return ret;
+}
+
 /* Wrapper function to calculate CRC
  * @crc: previous accumulated CRC
  * @buf: buffer base address
@@ -303,6 +303,15 @@ endef
 
 GZIP_SUFFIX := .gz
 
+# LZ4
+define LZ4_RULE
+$(1): $(2)
+	$(s)echo "  LZ4     $$@"
+	$(q)lz4 -9 -f -q $$< $$@
+endef
+
+LZ4_SUFFIX := .lz4
+
 ################################################################################
 # Auxiliary macros to build TF images from sources
 ################################################################################
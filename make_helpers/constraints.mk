@@ -137,6 +137,24 @@ ifeq ($(SPMC_AT_EL3_SEL0_SP),1)
                 $(error SEL0 SP cannot be enabled without SPMC at EL3)
         endif
 endif
+
+ifeq ($(SPMC_DIRECT_MSG_BATCH),1)
+        ifneq ($(SPMC_AT_EL3),1)
+                $(error SPMC_DIRECT_MSG_BATCH requires SPMC_AT_EL3)
+        endif
+endif
+
+ifeq ($(SPMC_DEFER_SP_INIT),1)
+        ifneq ($(SPMC_AT_EL3),1)
+                $(error SPMC_DEFER_SP_INIT requires SPMC_AT_EL3)
+        endif
+endif
+
+ifeq ($(SPMC_DEFER_SP_LOAD),1)
+        ifneq ($(SPMC_DEFER_SP_INIT),1)
+                $(error SPMC_DEFER_SP_LOAD requires SPMC_DEFER_SP_INIT)
+        endif
+endif
 endif #(SPD=spmd)
 endif #(SPD!=none)
 
@@ -156,6 +174,13 @@ ifeq (${USE_SPINLOCK_CAS},1)
         endif
 endif #(USE_SPINLOCK_CAS)
 
+# PSCI_IDLE_GOVERNOR relies on the residencies recorded by PSCI STATs
+ifeq (${PSCI_IDLE_GOVERNOR},1)
+        ifneq (${ENABLE_PSCI_STAT},1)
+               $(error PSCI_IDLE_GOVERNOR requires ENABLE_PSCI_STAT)
+        endif
+endif #(PSCI_IDLE_GOVERNOR)
+
 ifdef EL3_PAYLOAD_BASE
 	ifdef PRELOADED_BL33_BASE
                 $(warning "PRELOADED_BL33_BASE and EL3_PAYLOAD_BASE are \
@@ -216,6 +241,57 @@ ifeq ($(DYN_DISABLE_AUTH), 1)
 	endif
 endif #(DYN_DISABLE_AUTH)
 
+# IMAGE_HASH_STREAMING can be set only when TRUSTED_BOARD_BOOT=1
+ifeq ($(IMAGE_HASH_STREAMING), 1)
+	ifeq (${TRUSTED_BOARD_BOOT}, 0)
+                $(error "TRUSTED_BOARD_BOOT must be enabled for \
+                IMAGE_HASH_STREAMING to be set.")
+	endif
+endif #(IMAGE_HASH_STREAMING)
+
+# Images decompressed while they are read can only be authenticated by a hash
+# calculated at the same time
+ifeq ($(IMAGE_DECOMPRESS_STREAMING), 1)
+	ifeq (${TRUSTED_BOARD_BOOT}, 1)
+		ifeq (${IMAGE_HASH_STREAMING}, 0)
+                        $(error "IMAGE_HASH_STREAMING must be enabled for \
+                        IMAGE_DECOMPRESS_STREAMING to be set with \
+                        TRUSTED_BOARD_BOOT.")
+		endif
+	endif
+
+	# The measurements would no longer match those of the same FIP
+	# loaded without IMAGE_DECOMPRESS_STREAMING
+	ifeq (${MEASURED_BOOT}, 1)
+		ifeq (${MEASURE_DECOMPRESSED_IMAGES}, 0)
+                        $(error "IMAGE_DECOMPRESS_STREAMING measures the \
+                        decompressed images, MEASURE_DECOMPRESSED_IMAGES \
+                        must be set to accept it with MEASURED_BOOT.")
+		endif
+	endif
+endif #(IMAGE_DECOMPRESS_STREAMING)
+
+# AUTH_CERT_HANDOFF can be set only when TRUSTED_BOARD_BOOT=1 and
+# TRANSFER_LIST=1
+ifeq ($(AUTH_CERT_HANDOFF), 1)
+	ifeq (${TRUSTED_BOARD_BOOT}, 0)
+                $(error "TRUSTED_BOARD_BOOT must be enabled for \
+                AUTH_CERT_HANDOFF to be set.")
+	endif
+	ifeq (${TRANSFER_LIST}, 0)
+                $(error "TRANSFER_LIST must be enabled for \
+                AUTH_CERT_HANDOFF to be set.")
+	endif
+endif #(AUTH_CERT_HANDOFF)
+
+# ENABLE_SMC_LATENCY_HIST can be set only when ENABLE_PMF=1
+ifeq ($(ENABLE_SMC_LATENCY_HIST), 1)
+	ifeq (${ENABLE_PMF}, 0)
+                $(error "ENABLE_PMF must be enabled for \
+                ENABLE_SMC_LATENCY_HIST to be set.")
+	endif
+endif #(ENABLE_SMC_LATENCY_HIST)
+
 # SDEI_IN_FCONF is only supported when SDEI_SUPPORT is enabled.
 ifeq ($(SDEI_SUPPORT)-$(SDEI_IN_FCONF),0-1)
         $(error "SDEI_IN_FCONF is only supported when SDEI_SUPPORT is enabled")
@@ -362,6 +438,10 @@ ifeq (${ARCH},aarch32)
         ifneq (${USE_SPINLOCK_CAS},0)
                 $(error "USE_SPINLOCK_CAS is not supported with ARCH=aarch32")
         endif
+	# The bulk CPU_ON call is an SMC64 with a 64-bit Aff0 mask
+	ifneq (${PSCI_BULK_CPU_ON},0)
+                $(error "PSCI_BULK_CPU_ON cannot be used with ARCH=aarch32")
+	endif
 	ifneq (${PLATFORM_NODE_COUNT},1)
                 $(error "NUMA AWARE PER CPU is not supported with ARCH=aarch32")
 	endif
@@ -462,20 +542,12 @@ ifeq (${ENABLE_SVE_FOR_SWD}, 1)
 endif
 
 # Enabling SHA3 requires regular Crypto extension to be enabled
-ifeq (${ENABLE_FEAT_CRYPTO_SHA3}, 1)
+ifneq (${ENABLE_FEAT_CRYPTO_SHA3}, 0)
     ifeq (${ENABLE_FEAT_CRYPTO}, 0)
         $(error "ENABLE_FEAT_CRYPTO_SHA3 requires ENABLE_FEAT_CRYPTO")
     endif
 endif
 
-ifeq (${ENABLE_FEAT_CRYPTO_SHA3}, 2)
-    $(warning "ENABLE_FEAT_CRYPTO_SHA3 does not have any effect when set to 2")
-endif
-
-ifeq (${ENABLE_FEAT_CRYPTO}, 2)
-    $(warning "ENABLE_FEAT_CRYPTO does not have any effect when set to 2")
-endif
-
 # Enabling SVE in either world while enabling CTX_INCLUDE_FPREGS requires
 # CTX_INCLUDE_SVE_REGS to be enabled due to architectural dependency between FP
 # and SVE registers.
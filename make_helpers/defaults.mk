@@ -29,6 +29,10 @@ ARM_ARCH_FEATURE		:= none
 ARM_ARCH_MAJOR			:= 8
 ARM_ARCH_MINOR			:= 0
 
+# Hand the parameters of the certificates authenticated by BL1 over to BL2
+# through the transfer list, so that BL2 does not authenticate them again.
+AUTH_CERT_HANDOFF		:= 0
+
 # Base commit to perform code check on
 BASE_COMMIT			:= origin/master
 
@@ -85,6 +89,9 @@ DISABLE_BIN_GENERATION		:= 0
 # development platforms.
 DYN_DISABLE_AUTH		:= 0
 
+# Buffer BL31 runtime log messages in per-CPU rings instead of printing them
+ENABLE_DEFERRED_LOG		:= 0
+
 # Enable the SIMD crypto extension feature. The flags suppose to be in
 # arch_features.mk but since mbedtls_common.mk is included before arch_features.mk,
 # so this flag has to be defined here.
@@ -99,15 +106,24 @@ ENABLE_MPMM			:= 0
 # Flag to Enable Position Independant support (PIE)
 ENABLE_PIE			:= 0
 
+# Keep a copy of the FIP ToC in memory to look files up without reading it.
+FIP_TOC_CACHE			:= 0
+
 # Flag to enable Performance Measurement Framework
 ENABLE_PMF			:= 0
 
 # Flag to enable PSCI STATs functionality
 ENABLE_PSCI_STAT		:= 0
 
+# Flag to demote suspend requests using the PSCI STATs residency history
+PSCI_IDLE_GOVERNOR		:= 0
+
 # Flag to enable runtime instrumentation using PMF
 ENABLE_RUNTIME_INSTRUMENTATION	:= 0
 
+# Flag to enable per-SMC latency histograms using PMF
+ENABLE_SMC_LATENCY_HIST		:= 0
+
 # Flag to enable stack corruption protection
 ENABLE_STACK_PROTECTOR		:= 0
 
@@ -188,10 +204,20 @@ HARDEN_SLS			:= 0
 # The default value is sha256.
 HASH_ALG			:= sha256
 
+# Decompress images while they are read from the storage rather than once they
+# have been loaded to a temporary buffer.
+IMAGE_DECOMPRESS_STREAMING	:= 0
+
+# Hash images while they are loaded rather than once they have been loaded.
+IMAGE_HASH_STREAMING		:= 0
+
 # Whether system coherency is managed in hardware, without explicit software
 # operations.
 HW_ASSISTED_COHERENCY		:= 0
 
+# Enable the read cache of the IO block driver.
+IO_BLOCK_CACHE			:= 0
+
 # Flag to enable trapping of implementation defined sytem registers
 IMPDEF_SYSREG_TRAP		:= 0
 
@@ -206,6 +232,10 @@ endif
 # Option to build TF with Measured Boot support
 MEASURED_BOOT			:= 0
 
+# Accept that images decompressed while they are read are measured once
+# decompressed, rather than as stored in the FIP.
+MEASURE_DECOMPRESSED_IMAGES	:= 0
+
 # Option to build TF with Discrete TPM support
 DISCRETE_TPM			:= 0
 
@@ -231,6 +261,9 @@ PSCI_EXTENDED_STATE_ID		:= 0
 # Enable PSCI OS-initiated mode support
 PSCI_OS_INIT_MODE		:= 0
 
+# Enable the vendor-specific EL3 call turning on several CPUs at once
+PSCI_BULK_CPU_ON		:= 0
+
 # SMCCC_ARCH_FEATURE_AVAILABILITY support
 ARCH_FEATURE_AVAILABILITY	:= 0
 
@@ -294,6 +327,15 @@ SPMC_AT_EL3			:= 0
 # Enable SEL0 SP when SPMC is enabled at EL3
 SPMC_AT_EL3_SEL0_SP		:=0
 
+# Enable batched direct requests from the Normal world to the SPMC at EL3
+SPMC_DIRECT_MSG_BATCH		:= 0
+
+# Defer the initialisation of a S-EL0 SP by the SPMC at EL3 to its first use
+SPMC_DEFER_SP_INIT		:= 0
+
+# Let the platform load the S-EL0 SP from BL31 when it is first used
+SPMC_DEFER_SP_LOAD		:= 0
+
 # Use SPM at S-EL2 as a default config for SPMD
 SPMD_SPM_AT_SEL2		:= 1
 
@@ -345,6 +387,9 @@ USE_TBBR_DEFS			:= 1
 # platforms).
 WARMBOOT_ENABLE_DCACHE_EARLY	:= 0
 
+# Access compressed images in place when they sit on memory-mapped storage
+ZERO_COPY_IMAGE_LOAD		:= 0
+
 # Default SVE vector length to maximum architected value
 SVE_VECTOR_LEN			:= 2048
 
@@ -428,6 +473,10 @@ INIT_UNUSED_NS_EL2		:= 0
 # it's only enabled for NS world
 CTX_INCLUDE_MPAM_REGS		:= 0
 
+# Skip writing EL2 registers which hold the same value in both worlds on SPMD
+# world switches
+CTX_EL2_LAZY_RESTORE		:= 0
+
 # Enable context memory usage reporting during BL31 setup.
 PLATFORM_REPORT_CTX_MEM_USE	:= 0
 
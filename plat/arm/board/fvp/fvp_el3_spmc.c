@@ -3,6 +3,13 @@
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
+
+#include <stdbool.h>
+
+#include <common/bl_common.h>
+#include <common/debug.h>
+#include <lib/xlat_tables/xlat_tables_compat.h>
+#include <plat/arm/common/plat_arm.h>
 #include <services/el3_spmc_ffa_memory.h>
 
 #include <platform_def.h>
@@ -39,3 +46,66 @@ int plat_spmc_shmem_reclaim(struct ffa_mtd *desc)
 {
 	return 0;
 }
+
+#if defined(IMAGE_BL31) && SPMC_DEFER_SP_LOAD
+/*
+ * Load the S-EL0 SP, which is the BL32 image on FVP, from the FIP in flash to
+ * the BL32 region, both only mapped into BL31 for the duration of the load.
+ * BL31 has no authentication framework, so this is limited to builds without
+ * TRUSTED_BOARD_BOOT or DECRYPTION_SUPPORT (see platform.mk).
+ */
+int plat_spmc_sp_load(uint16_t sp_id)
+{
+	static bool io_setup_done;
+	image_info_t image_info = {
+		.h.type = (uint8_t)PARAM_IMAGE_BINARY,
+		.h.version = (uint8_t)VERSION_2,
+		.h.size = (uint16_t)sizeof(image_info_t),
+		.image_base = BL32_BASE,
+		.image_max_size = BL32_LIMIT - BL32_BASE,
+	};
+	int rc, ret;
+
+	if (!io_setup_done) {
+		plat_arm_io_setup();
+		io_setup_done = true;
+	}
+
+	rc = mmap_add_dynamic_region(V2M_FLASH0_BASE, V2M_FLASH0_BASE,
+				     V2M_FLASH0_SIZE,
+				     MT_DEVICE | MT_RO | MT_SECURE);
+	if (rc != 0) {
+		ERROR("Error while mapping the FIP (%d).\n", rc);
+		return rc;
+	}
+
+	rc = mmap_add_dynamic_region(BL32_BASE, BL32_BASE,
+				     BL32_LIMIT - BL32_BASE,
+				     MT_MEMORY | MT_RW | MT_SECURE);
+	if (rc != 0) {
+		ERROR("Error while mapping the SP region (%d).\n", rc);
+		(void)mmap_remove_dynamic_region(V2M_FLASH0_BASE,
+						 V2M_FLASH0_SIZE);
+		return rc;
+	}
+
+	ret = load_auth_image(BL32_IMAGE_ID, &image_info);
+	if (ret != 0) {
+		ERROR("Failed to load SP (0x%x) (%d).\n", sp_id, ret);
+	}
+
+	rc = mmap_remove_dynamic_region(BL32_BASE, BL32_LIMIT - BL32_BASE);
+	if (rc != 0) {
+		ERROR("Error while unmapping the SP region (%d).\n", rc);
+		panic();
+	}
+
+	rc = mmap_remove_dynamic_region(V2M_FLASH0_BASE, V2M_FLASH0_SIZE);
+	if (rc != 0) {
+		ERROR("Error while unmapping the FIP (%d).\n", rc);
+		panic();
+	}
+
+	return ret;
+}
+#endif /* IMAGE_BL31 && SPMC_DEFER_SP_LOAD */
@@ -154,6 +154,14 @@
 
 #if TRANSFER_LIST
 
+#if AUTH_CERT_HANDOFF
+/*
+ * Use the value following the TB_FW_CONFIG one in the non-standard range as
+ * the tag_id for the parameters of the certificates authenticated by BL1.
+ */
+#define PLAT_ARM_AUTH_HANDOFF_TL_TAG	0x00fff001
+#endif /* AUTH_CERT_HANDOFF */
+
 /* Define maximum size of sp manifest file. */
 #if defined(SPD_spmd)
 #define PLAT_ARM_SPMC_SP_MANIFEST_SIZE	SZ_4K
@@ -232,8 +240,14 @@
 #  define PLAT_SP_IMAGE_MMAP_REGIONS	30
 #  define PLAT_SP_IMAGE_MAX_XLAT_TABLES	12
 # elif SPMC_AT_EL3
-#  define PLAT_ARM_MMAP_ENTRIES		13
-#  define MAX_XLAT_TABLES		11
+#  if SPMC_DEFER_SP_LOAD
+/* The FIP and the SP region are mapped while the SP is loaded */
+#   define PLAT_ARM_MMAP_ENTRIES	15
+#   define MAX_XLAT_TABLES		12
+#  else
+#   define PLAT_ARM_MMAP_ENTRIES	13
+#   define MAX_XLAT_TABLES		11
+#  endif
 #  define PLAT_SP_IMAGE_MMAP_REGIONS	31
 #  define PLAT_SP_IMAGE_MAX_XLAT_TABLES	13
 # else
@@ -539,6 +539,18 @@ ifeq (${SPMC_AT_EL3}, 1)
 PLAT_BL_COMMON_SOURCES	+=	plat/arm/board/fvp/fvp_el3_spmc.c
 endif
 
+# BL31 loads the SP from the FIP, but has no authentication or decryption
+# framework
+ifeq (${SPMC_DEFER_SP_LOAD}, 1)
+    ifneq (${TRUSTED_BOARD_BOOT}-${DECRYPTION_SUPPORT}, 0-none)
+        $(error "SPMC_DEFER_SP_LOAD on FVP requires TRUSTED_BOARD_BOOT=0 and DECRYPTION_SUPPORT=none")
+    endif
+BL31_SOURCES		+=	drivers/io/io_fip.c				\
+				drivers/io/io_memmap.c				\
+				drivers/io/io_storage.c				\
+				${ARM_IO_SOURCES}
+endif
+
 PSCI_OS_INIT_MODE	:=	1
 
 ifeq (${SPD},spmd)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -12,6 +12,7 @@
 #include <bl1/bl1.h>
 #include <common/bl_common.h>
 #include <common/debug.h>
+#include <drivers/auth/auth_mod.h>
 #include <lib/fconf/fconf.h>
 #include <lib/fconf/fconf_dyn_cfg_getter.h>
 #if TRANSFER_LIST
@@ -22,6 +23,10 @@
 #include <plat/arm/common/plat_arm.h>
 #include <plat/common/platform.h>
 
+#if AUTH_CERT_HANDOFF && !defined(PLAT_ARM_AUTH_HANDOFF_TL_TAG)
+#error "AUTH_CERT_HANDOFF requires the platform to define PLAT_ARM_AUTH_HANDOFF_TL_TAG"
+#endif
+
 /* Weak definitions may be overridden in specific ARM standard platform */
 #pragma weak bl1_early_platform_setup
 #pragma weak bl1_plat_arch_setup
@@ -329,6 +334,23 @@ int bl1_plat_handle_post_image_load(unsigned int image_id)
 	bl1_plat_calc_bl2_layout(&bl1_tzram_layout,
 				 (meminfo_t *)transfer_list_entry_data(te));
 
+#if AUTH_CERT_HANDOFF
+	/*
+	 * Hand over the parameters of the certificates authenticated while
+	 * loading BL2, so that BL2 does not authenticate them again.
+	 */
+	size_t auth_size = auth_mod_export_verified(NULL, 0U);
+
+	if (auth_size != 0U) {
+		te = transfer_list_add(secure_tl, PLAT_ARM_AUTH_HANDOFF_TL_TAG,
+				       auth_size, NULL);
+		if (te != NULL) {
+			(void)auth_mod_export_verified(
+				transfer_list_entry_data(te), auth_size);
+		}
+	}
+#endif /* AUTH_CERT_HANDOFF */
+
 	transfer_list_update_checksum(secure_tl);
 
 	/**
@@ -14,6 +14,7 @@
 #include <common/bl_common.h>
 #include <common/debug.h>
 #include <common/desc_image_load.h>
+#include <drivers/auth/auth_mod.h>
 #include <drivers/generic_delay_timer.h>
 #include <drivers/partition/partition.h>
 #include <lib/fconf/fconf.h>
@@ -29,6 +30,10 @@
 #include <plat/arm/common/plat_arm.h>
 #include <plat/common/platform.h>
 
+#if AUTH_CERT_HANDOFF && !defined(PLAT_ARM_AUTH_HANDOFF_TL_TAG)
+#error "AUTH_CERT_HANDOFF requires the platform to define PLAT_ARM_AUTH_HANDOFF_TL_TAG"
+#endif
+
 /* Data structure which holds the extents of the trusted SRAM for BL2 */
 static meminfo_t bl2_tzram_layout __aligned(CACHE_WRITEBACK_GRANULE);
 
@@ -241,6 +246,23 @@ void bl2_plat_preload_setup(void)
 	}
 #endif /* RESET_TO_BL2 */
 	arm_transfer_list_dyn_cfg_init(secure_tl);
+
+#if AUTH_CERT_HANDOFF && !RESET_TO_BL2
+	struct transfer_list_entry *te;
+
+	/*
+	 * Trust the certificates that BL1 has authenticated, now that the CoT
+	 * is set up and before any image is loaded.
+	 */
+	te = transfer_list_find(secure_tl, PLAT_ARM_AUTH_HANDOFF_TL_TAG);
+	if (te != NULL) {
+		if (auth_mod_import_verified(transfer_list_entry_data(te),
+					     te->data_size) != 0) {
+			WARN("Malformed authentication handoff from BL1\n");
+		}
+		transfer_list_rem(secure_tl, te);
+	}
+#endif /* AUTH_CERT_HANDOFF */
 #else /* !TRANSFER_LIST */
 #if ARM_FW_CONFIG_LOAD_ENABLE
 	arm_bl2_plat_config_load();
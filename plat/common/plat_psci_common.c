@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2016-2026, Arm Limited and Contributors. All rights reserved.
  * Copyright (c) 2020, NVIDIA Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -146,6 +146,23 @@ u_register_t plat_psci_stat_get_residency(unsigned int lvl,
 }
 #endif /* ENABLE_PSCI_STAT && ENABLE_PMF */
 
+#if PSCI_IDLE_GOVERNOR
+#pragma weak plat_psci_idle_break_even_time
+
+/*
+ * Return the break-even time of a local power state in microseconds. The
+ * default of 0 never lets the idle governor demote a request.
+ */
+u_register_t plat_psci_idle_break_even_time(unsigned int lvl,
+	plat_local_state_t local_state)
+{
+	(void)lvl;
+	(void)local_state;
+
+	return 0U;
+}
+#endif /* PSCI_IDLE_GOVERNOR */
+
 /*
  * The PSCI generic code uses this API to let the platform participate in state
  * coordination during a power management operation. It compares the platform
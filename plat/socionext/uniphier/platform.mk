@@ -1,5 +1,5 @@
 #
-# Copyright (c) 2017-2025, Arm Limited and Contributors. All rights reserved.
+# Copyright (c) 2017-2026, Arm Limited and Contributors. All rights reserved.
 #
 # SPDX-License-Identifier: BSD-3-Clause
 #
@@ -117,6 +117,10 @@ $(ROTPK_HASH): $(ROT_KEY) | $$(@D)/
 
 endif
 
+ifeq (${FIP_GZIP}${FIP_LZ4},11)
+$(error FIP_GZIP and FIP_LZ4 cannot be enabled at the same time)
+endif
+
 ifeq (${FIP_GZIP},1)
 
 include lib/zlib/zlib.mk
@@ -134,6 +138,23 @@ BL33_PRE_TOOL_FILTER	:= GZIP
 
 endif
 
+ifeq (${FIP_LZ4},1)
+
+include lib/lz4/lz4.mk
+
+BL2_SOURCES		+=	common/image_decompress.c		\
+				$(LZ4_SOURCES)
+
+$(eval $(call add_define,UNIPHIER_DECOMPRESS_LZ4))
+
+# compress all images loaded by BL2
+SCP_BL2_PRE_TOOL_FILTER	:= LZ4
+BL31_PRE_TOOL_FILTER	:= LZ4
+BL32_PRE_TOOL_FILTER	:= LZ4
+BL33_PRE_TOOL_FILTER	:= LZ4
+
+endif
+
 .PHONY: bl2_gzip
 bl2_gzip: $(BUILD_PLAT)/bl2.bin.gz
 $(BUILD_PLAT)/bl2.bin.gz: %.gz: %
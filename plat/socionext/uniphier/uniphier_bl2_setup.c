@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2025, ARM Limited and Contributors. All rights reserved.
+ * Copyright (c) 2017-2026, ARM Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -15,8 +15,12 @@
 #include <drivers/io/io_storage.h>
 #include <lib/xlat_tables/xlat_tables_v2.h>
 #include <plat/common/platform.h>
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#if defined(UNIPHIER_DECOMPRESS_GZIP)
 #include <tf_gunzip.h>
+#define UNIPHIER_DECOMPRESS
+#elif defined(UNIPHIER_DECOMPRESS_LZ4)
+#include <tf_lz4.h>
+#define UNIPHIER_DECOMPRESS
 #endif
 
 #include "uniphier.h"
@@ -28,6 +32,20 @@ static uintptr_t uniphier_mem_base = UNIPHIER_MEM_BASE;
 static unsigned int uniphier_soc = UNIPHIER_SOC_UNKNOWN;
 static int uniphier_bl2_kick_scp;
 
+#if defined(UNIPHIER_DECOMPRESS) && IMAGE_DECOMPRESS_STREAMING
+static const decompressor_stream_t uniphier_decompressor_stream = {
+#ifdef UNIPHIER_DECOMPRESS_GZIP
+	.start = gunzip_stream_start,
+	.update = gunzip_stream_update,
+	.finish = gunzip_stream_finish,
+#else
+	.start = lz4_stream_start,
+	.update = lz4_stream_update,
+	.finish = lz4_stream_finish,
+#endif
+};
+#endif
+
 void bl2_early_platform_setup2(u_register_t x0, u_register_t x1,
 				  u_register_t x2, u_register_t x3)
 {
@@ -110,7 +128,7 @@ bl_params_t *plat_get_next_bl_params(void)
 
 void bl2_plat_preload_setup(void)
 {
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	uintptr_t buf_base = uniphier_mem_base + UNIPHIER_IMAGE_BUF_OFFSET;
 	int ret;
 
@@ -120,7 +138,15 @@ void bl2_plat_preload_setup(void)
 	if (ret)
 		plat_error_handler(ret);
 
+#if IMAGE_DECOMPRESS_STREAMING
+	image_decompress_stream_init(buf_base, UNIPHIER_IMAGE_BUF_SIZE,
+				     &uniphier_decompressor_stream);
+#elif defined(UNIPHIER_DECOMPRESS_GZIP)
 	image_decompress_init(buf_base, UNIPHIER_IMAGE_BUF_SIZE, gunzip);
+#else
+	image_decompress_init(buf_base, UNIPHIER_IMAGE_BUF_SIZE,
+			      lz4_decompress);
+#endif
 #endif
 
 	uniphier_init_image_descs(uniphier_mem_base);
@@ -140,7 +166,7 @@ int bl2_plat_handle_pre_image_load(unsigned int image_id)
 	if (ret)
 		return ret;
 
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	image_decompress_prepare(image_info);
 #endif
 	return 0;
@@ -149,7 +175,7 @@ int bl2_plat_handle_pre_image_load(unsigned int image_id)
 int bl2_plat_handle_post_image_load(unsigned int image_id)
 {
 	struct image_info *image_info = uniphier_get_image_info(image_id);
-#ifdef UNIPHIER_DECOMPRESS_GZIP
+#ifdef UNIPHIER_DECOMPRESS
 	int ret;
 
 	if (!(image_info->h.attr & IMAGE_ATTRIB_SKIP_LOADING)) {
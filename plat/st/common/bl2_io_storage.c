@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2015-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -351,6 +351,9 @@ static int try_nand_backup_partitions(unsigned int image_id)
 			NOTICE("BL2: active FIP exhausted, falling back to recovery FIP\n");
 			image_block_spec.offset = STM32MP_NAND_FIP_RECOVERY_OFFSET;
 			backup_block_nb = nand_backup_block_count();
+#if FIP_TOC_CACHE
+			fip_dev_invalidate_toc_cache();
+#endif
 			return 0;
 		}
 #endif
@@ -367,6 +370,11 @@ static int try_nand_backup_partitions(unsigned int image_id)
 
 	image_block_spec.offset += nand_block_sz;
 
+#if FIP_TOC_CACHE
+	/* The FIP is now read from another offset behind the same spec */
+	fip_dev_invalidate_toc_cache();
+#endif
+
 	return 0;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2024-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2024-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,10 +10,12 @@
 #include <common/runtime_svc.h>
 #include <lib/debugfs.h>
 #include <lib/pmf/pmf.h>
+#include <lib/psci/psci_lib.h>
 #if PLAT_ARM_ACS_SMC_HANDLER
 #include <plat/arm/common/plat_acs_smc_handler.h>
 #endif /* PLAT_ARM_ACS_SMC_HANDLER */
 #include <services/spm_mm_svc.h>
+#include <services/spmc_svc.h>
 #include <services/ven_el3_svc.h>
 #include <tools_share/uuid.h>
 
@@ -102,6 +104,26 @@ static uintptr_t ven_el3_svc_handler(unsigned int smc_fid,
 						handle, flags);
 		break;
 #endif
+#if PSCI_BULK_CPU_ON
+	case PSCI_BULK_CPU_ON_SMC64:
+	{
+		u_register_t on_mask;
+		int ret;
+
+		if (is_caller_secure(flags)) {
+			SMC_RET1(handle, SMC_UNK);
+		}
+
+		ret = psci_cpu_on_bulk(x1, x2, x3, x4, &on_mask);
+		SMC_RET2(handle, (u_register_t)ret, on_mask);
+		break;
+	}
+#endif /* PSCI_BULK_CPU_ON */
+#if SPMC_DIRECT_MSG_BATCH
+	case SPMC_DIRECT_REQ_BATCH_SMC64:
+		return spmc_smc_handler(smc_fid, is_caller_secure(flags), x1,
+					x2, x3, x4, cookie, handle, flags);
+#endif /* SPMC_DIRECT_MSG_BATCH */
 	default:
 		WARN("Unimplemented vendor-specific EL3 Service call: 0x%x\n", smc_fid);
 		SMC_RET1(handle, SMC_UNK);
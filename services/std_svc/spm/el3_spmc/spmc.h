@@ -143,6 +143,15 @@ struct sp_exec_ctx {
 
 	/* Track direct message function id to validate a direct response. */
 	uint16_t dir_req_funcid;
+
+#if SPMC_DIRECT_MSG_BATCH
+	/*
+	 * Number of requests of the SPMC_DIRECT_REQ_BATCH_SMC64 batch being
+	 * handled, 0 if none, and index of the request currently handled.
+	 */
+	uint32_t batch_count;
+	uint32_t batch_next;
+#endif
 };
 
 struct ffa_uuid {
@@ -214,6 +223,11 @@ struct secure_partition_desc {
 	 * management transactions if it is using FF-A v1.0.
 	 */
 	bool ns_bit_requested;
+
+#if SPMC_DEFER_SP_INIT
+	/* Set while the initialisation of the SP is deferred to its first use. */
+	volatile bool init_pending;
+#endif
 };
 
 /*
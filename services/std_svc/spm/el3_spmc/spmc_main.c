@@ -71,6 +71,10 @@ static uint64_t spmc_sp_interrupt_handler(uint32_t id,
 					  void *handle,
 					  void *cookie);
 
+#if SPMC_DEFER_SP_INIT
+static void spmc_sp_deferred_init(struct secure_partition_desc *sp);
+#endif
+
 /*
  * Helper function to obtain the array storing the EL3
  * Logical Partition descriptors.
@@ -437,6 +441,285 @@ uint32_t get_partition_ffa_version(bool secure_origin)
 	return spmc_get_ns_ep_ffa_version(spmc_get_hyp_ctx());
 }
 
+#if SPMC_DIRECT_MSG_BATCH
+/*******************************************************************************
+ * Helpers for SPMC_DIRECT_REQ_BATCH_SMC64. The requests are read from the TX
+ * buffer of the Normal world and their completions written to its RX buffer.
+ * Both are accessed with the mailbox lock held, as they could be unmapped while
+ * the batch is being handled.
+ ******************************************************************************/
+static size_t direct_batch_max_count(const struct mailbox *mbox)
+{
+	return ((size_t)mbox->rxtx_page_count * FFA_PAGE_SIZE) /
+	       sizeof(struct spmc_direct_batch_entry);
+}
+
+static bool direct_batch_load(uint32_t index,
+			      struct spmc_direct_batch_entry *entry)
+{
+	struct mailbox *mbox = spmc_get_mbox_desc(false);
+	const struct spmc_direct_batch_entry *reqs;
+	bool loaded = false;
+
+	spin_lock(&mbox->lock);
+	if ((mbox->tx_buffer != NULL) && (index < direct_batch_max_count(mbox))) {
+		reqs = mbox->tx_buffer;
+		*entry = reqs[index];
+		loaded = true;
+	}
+	spin_unlock(&mbox->lock);
+
+	return loaded;
+}
+
+/*
+ * Store the completion of a request: the direct response held in the context
+ * of the responder, or the FF-A error code @status returned instead of it.
+ */
+static void direct_batch_store(uint32_t index, int32_t status, void *handle)
+{
+	struct mailbox *mbox = spmc_get_mbox_desc(false);
+	struct spmc_direct_batch_entry *resp;
+
+	spin_lock(&mbox->lock);
+	if ((mbox->rx_buffer != NULL) && (index < direct_batch_max_count(mbox))) {
+		resp = (struct spmc_direct_batch_entry *)mbox->rx_buffer + index;
+		resp->status = status;
+		resp->reserved = 0U;
+		if (status == 0) {
+			resp->args[0] = SMC_GET_GP(handle, CTX_GPREG_X3);
+			resp->args[1] = SMC_GET_GP(handle, CTX_GPREG_X4);
+			resp->args[2] = SMC_GET_GP(handle, CTX_GPREG_X5);
+			resp->args[3] = SMC_GET_GP(handle, CTX_GPREG_X6);
+			resp->args[4] = SMC_GET_GP(handle, CTX_GPREG_X7);
+		} else {
+			zeromem(resp->args, sizeof(resp->args));
+		}
+	}
+	spin_unlock(&mbox->lock);
+}
+
+/* Set up the x5-x7 payload of a request forwarded from the context @handle */
+static void direct_batch_set_payload(void *handle,
+				     const struct spmc_direct_batch_entry *entry)
+{
+	SMC_SET_GP(handle, CTX_GPREG_X5, entry->args[2]);
+	SMC_SET_GP(handle, CTX_GPREG_X6, entry->args[3]);
+	SMC_SET_GP(handle, CTX_GPREG_X7, entry->args[4]);
+}
+
+static void direct_batch_release_rx(void)
+{
+	struct mailbox *mbox = spmc_get_mbox_desc(false);
+
+	spin_lock(&mbox->lock);
+	mbox->state = MAILBOX_STATE_EMPTY;
+	spin_unlock(&mbox->lock);
+}
+
+/*
+ * Record the completion of the current request of the batch handled by the
+ * execution context @ec of @sp, with the response or FF-A error code @status
+ * held in @handle. If there is another request, set it up in @handle to hand
+ * it straight back to the SP, without going through the Normal world, and
+ * return 0. Otherwise end the batch and return the number of requests handled.
+ * Called with the runtime state lock of the SP held.
+ */
+static uint32_t direct_batch_complete(struct secure_partition_desc *sp,
+				      struct sp_exec_ctx *ec, int32_t status,
+				      void *handle)
+{
+	struct spmc_direct_batch_entry entry;
+	uint32_t next;
+
+	direct_batch_store(ec->batch_next, status, handle);
+	next = ++ec->batch_next;
+
+	if ((next < ec->batch_count) && direct_batch_load(next, &entry)) {
+		SMC_SET_GP(handle, CTX_GPREG_X0, FFA_MSG_SEND_DIRECT_REQ_SMC64);
+		SMC_SET_GP(handle, CTX_GPREG_X1,
+			   ((uint32_t)ec->dir_req_origin_id <<
+			    FFA_DIRECT_MSG_SOURCE_SHIFT) | sp->sp_id);
+		SMC_SET_GP(handle, CTX_GPREG_X2, 0U);
+		SMC_SET_GP(handle, CTX_GPREG_X3, entry.args[0]);
+		SMC_SET_GP(handle, CTX_GPREG_X4, entry.args[1]);
+		direct_batch_set_payload(handle, &entry);
+		return 0U;
+	}
+
+	ec->batch_count = 0U;
+
+	return next;
+}
+
+/* Complete the batch to the Normal world with the number of requests handled */
+static uint64_t direct_batch_return(struct secure_partition_desc *sp,
+				    uint32_t done, uint16_t dst_id,
+				    void *cookie, void *handle, uint64_t flags)
+{
+	SMC_SET_GP(handle, CTX_GPREG_X5, 0U);
+	SMC_SET_GP(handle, CTX_GPREG_X6, 0U);
+	SMC_SET_GP(handle, CTX_GPREG_X7, 0U);
+
+	return spmc_smc_return(FFA_SUCCESS_SMC32, true, 0U, done, 0U, 0U,
+			       handle, cookie, flags, dst_id,
+			       spmc_get_sp_ffa_version(sp));
+}
+
+/*******************************************************************************
+ * Handle a batch of direct requests from the Normal world. The requests are
+ * handled one after the other by the destination partition and the SMC only
+ * returns to the Normal world once all of them have completed, with the number
+ * of completed requests in w2. A request the partition fails with FFA_ERROR
+ * has the error code recorded in its completion and does not stop the batch.
+ * Logical partitions handle the whole batch within EL3. Requests to an SP are
+ * handed back to it as soon as it completes the previous one, see
+ * direct_resp_smc_handler() and ffa_error_handler().
+ *
+ * The RX buffer holds the completions and is owned by the caller until it
+ * releases it with FFA_RX_RELEASE.
+ ******************************************************************************/
+static uint64_t direct_req_batch_smc_handler(uint32_t smc_fid,
+					     bool secure_origin,
+					     uint64_t x1,
+					     uint64_t x2,
+					     uint64_t x3,
+					     uint64_t x4,
+					     void *cookie,
+					     void *handle,
+					     uint64_t flags)
+{
+	uint16_t src_id = ffa_endpoint_source(x1);
+	uint16_t dst_id = ffa_endpoint_destination(x1);
+	uint32_t count = (uint32_t)x2;
+	struct spmc_direct_batch_entry entry;
+	struct el3_lp_desc *lp = NULL;
+	struct el3_lp_desc *el3_lp_descs;
+	struct secure_partition_desc *sp = NULL;
+	struct mailbox *mbox;
+	unsigned int idx;
+	uint32_t i;
+
+	if (secure_origin || !ffa_is_normal_world_id(src_id)) {
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
+
+	el3_lp_descs = get_el3_lp_array();
+	for (i = 0U; i < MAX_EL3_LP_DESCS_COUNT; i++) {
+		if (el3_lp_descs[i].sp_id == dst_id) {
+			lp = &el3_lp_descs[i];
+			break;
+		}
+	}
+
+	if (lp == NULL) {
+		sp = spmc_get_sp_ctx(dst_id);
+		if (sp == NULL) {
+			VERBOSE("Direct request to unknown partition ID (0x%x).\n",
+				dst_id);
+			return spmc_ffa_error_return(handle,
+						     FFA_ERROR_INVALID_PARAMETER);
+		}
+	}
+
+	if (!direct_msg_receivable((lp != NULL) ? lp->properties :
+				   sp->properties,
+				   FFA_FNUM_MSG_SEND_DIRECT_REQ)) {
+		return spmc_ffa_error_return(handle, FFA_ERROR_DENIED);
+	}
+
+#if SPMC_DEFER_SP_INIT
+	if (sp != NULL) {
+		spmc_sp_deferred_init(sp);
+	}
+#endif
+
+	/* Take ownership of the RX buffer to write the completions to it. */
+	mbox = spmc_get_mbox_desc(secure_origin);
+	spin_lock(&mbox->lock);
+
+	if ((count == 0U) || (count > direct_batch_max_count(mbox))) {
+		spin_unlock(&mbox->lock);
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
+
+	if (mbox->state != MAILBOX_STATE_EMPTY) {
+		spin_unlock(&mbox->lock);
+		return spmc_ffa_error_return(handle, FFA_ERROR_BUSY);
+	}
+
+	mbox->state = MAILBOX_STATE_FULL;
+	spin_unlock(&mbox->lock);
+
+	if (lp != NULL) {
+		for (i = 0U; i < count; i++) {
+			if (!direct_batch_load(i, &entry)) {
+				break;
+			}
+
+			direct_batch_set_payload(handle, &entry);
+			(void)lp->direct_req(FFA_MSG_SEND_DIRECT_REQ_SMC64,
+					     secure_origin, x1, 0U,
+					     entry.args[0], entry.args[1],
+					     cookie, handle, flags);
+			if (SMC_GET_GP(handle, CTX_GPREG_X0) == FFA_ERROR) {
+				direct_batch_store(i, (int32_t)SMC_GET_GP(handle,
+							CTX_GPREG_X2), handle);
+				continue;
+			}
+
+			if (!direct_msg_validate_lp_resp(src_id, dst_id,
+							 handle)) {
+				panic();
+			}
+
+			direct_batch_store(i, 0, handle);
+		}
+
+		SMC_RET8(handle, FFA_SUCCESS_SMC32, 0U, i, 0U, 0U, 0U, 0U, 0U);
+	}
+
+	if (!direct_batch_load(0U, &entry)) {
+		direct_batch_release_rx();
+		return spmc_ffa_error_return(handle,
+					     FFA_ERROR_INVALID_PARAMETER);
+	}
+
+	/* Protect the runtime state of a UP S-EL0 SP with a lock. */
+	if (sp->runtime_el == S_EL0) {
+		spin_lock(&sp->rt_state_lock);
+	}
+
+	idx = get_ec_index(sp);
+	if (sp->ec[idx].rt_state != RT_STATE_WAITING) {
+		if (sp->runtime_el == S_EL0) {
+			spin_unlock(&sp->rt_state_lock);
+		}
+		direct_batch_release_rx();
+		return spmc_ffa_error_return(handle, FFA_ERROR_BUSY);
+	}
+
+	sp->ec[idx].rt_state = RT_STATE_RUNNING;
+	sp->ec[idx].rt_model = RT_MODEL_DIR_REQ;
+	sp->ec[idx].dir_req_origin_id = src_id;
+	sp->ec[idx].dir_req_funcid = FFA_FNUM_MSG_SEND_DIRECT_REQ;
+	sp->ec[idx].batch_count = count;
+	sp->ec[idx].batch_next = 0U;
+
+	if (sp->runtime_el == S_EL0) {
+		spin_unlock(&sp->rt_state_lock);
+	}
+
+	direct_batch_set_payload(handle, &entry);
+	return spmc_smc_return(FFA_MSG_SEND_DIRECT_REQ_SMC64, secure_origin,
+			       x1, 0U, entry.args[0], entry.args[1], handle,
+			       cookie, flags, dst_id,
+			       spmc_get_sp_ffa_version(sp));
+}
+#endif /* SPMC_DIRECT_MSG_BATCH */
+
 /*******************************************************************************
  * Handle direct request messages and route to the appropriate destination.
  ******************************************************************************/
@@ -530,6 +813,12 @@ static uint64_t direct_req_smc_handler(uint32_t smc_fid,
 		return spmc_ffa_error_return(handle, FFA_ERROR_DENIED);
 	}
 
+#if SPMC_DEFER_SP_INIT
+	if (!secure_origin) {
+		spmc_sp_deferred_init(sp);
+	}
+#endif
+
 	/* Protect the runtime state of a UP S-EL0 SP with a lock. */
 	if (sp->runtime_el == S_EL0) {
 		spin_lock(&sp->rt_state_lock);
@@ -559,6 +848,9 @@ static uint64_t direct_req_smc_handler(uint32_t smc_fid,
 	sp->ec[idx].rt_model = RT_MODEL_DIR_REQ;
 	sp->ec[idx].dir_req_origin_id = src_id;
 	sp->ec[idx].dir_req_funcid = dir_req_funcid;
+#if SPMC_DIRECT_MSG_BATCH
+	sp->ec[idx].batch_count = 0U;
+#endif
 
 	if (sp->runtime_el == S_EL0) {
 		spin_unlock(&sp->rt_state_lock);
@@ -586,6 +878,9 @@ static uint64_t direct_resp_smc_handler(uint32_t smc_fid,
 	uint16_t dir_req_funcid;
 	struct secure_partition_desc *sp;
 	unsigned int idx;
+#if SPMC_DIRECT_MSG_BATCH
+	uint32_t batch_done = 0U;
+#endif
 
 	dir_req_funcid = (smc_fid != FFA_MSG_SEND_DIRECT_RESP2_SMC64) ?
 		FFA_FNUM_MSG_SEND_DIRECT_REQ : FFA_FNUM_MSG_SEND_DIRECT_REQ2;
@@ -659,6 +954,19 @@ static uint64_t direct_resp_smc_handler(uint32_t smc_fid,
 		return spmc_ffa_error_return(handle, FFA_ERROR_DENIED);
 	}
 
+#if SPMC_DIRECT_MSG_BATCH
+	if (sp->ec[idx].batch_count != 0U) {
+		batch_done = direct_batch_complete(sp, &sp->ec[idx], 0, handle);
+		if (batch_done == 0U) {
+			if (sp->runtime_el == S_EL0) {
+				spin_unlock(&sp->rt_state_lock);
+			}
+
+			SMC_RET0(handle);
+		}
+	}
+#endif
+
 	/* Update the state of the SP execution context. */
 	sp->ec[idx].rt_state = RT_STATE_WAITING;
 
@@ -682,6 +990,13 @@ static uint64_t direct_resp_smc_handler(uint32_t smc_fid,
 		panic();
 	}
 
+#if SPMC_DIRECT_MSG_BATCH
+	if (batch_done != 0U) {
+		return direct_batch_return(sp, batch_done, dst_id, cookie,
+					   handle, flags);
+	}
+#endif
+
 	return spmc_smc_return(smc_fid, secure_origin, x1, x2, x3, x4,
 			       handle, cookie, flags, dst_id,
 			       spmc_get_sp_ffa_version(sp));
@@ -793,6 +1108,9 @@ static uint64_t ffa_error_handler(uint32_t smc_fid,
 	unsigned int idx;
 	uint16_t dst_id = ffa_endpoint_destination(x1);
 	bool cancel_dir_req = false;
+#if SPMC_DIRECT_MSG_BATCH
+	uint32_t batch_done = 0U;
+#endif
 
 	/* Check that the response did not originate from the Normal world. */
 	if (!secure_origin) {
@@ -826,6 +1144,25 @@ static uint64_t ffa_error_handler(uint32_t smc_fid,
 
 	if (sp->ec[idx].rt_state == RT_STATE_RUNNING &&
 			sp->ec[idx].rt_model == RT_MODEL_DIR_REQ) {
+#if SPMC_DIRECT_MSG_BATCH
+		/*
+		 * Record the error as the completion of the current request of
+		 * a batch, and carry on with the next one.
+		 */
+		if (sp->ec[idx].batch_count != 0U) {
+			batch_done = direct_batch_complete(sp, &sp->ec[idx],
+							   (int32_t)x2, handle);
+			if (batch_done == 0U) {
+				if (sp->runtime_el == S_EL0) {
+					spin_unlock(&sp->rt_state_lock);
+				}
+
+				SMC_RET0(handle);
+			}
+
+			dst_id = sp->ec[idx].dir_req_origin_id;
+		}
+#endif
 		sp->ec[idx].rt_state = RT_STATE_WAITING;
 		sp->ec[idx].dir_req_origin_id = INV_SP_ID;
 		sp->ec[idx].dir_req_funcid = 0x00;
@@ -841,10 +1178,16 @@ static uint64_t ffa_error_handler(uint32_t smc_fid,
 			spmc_sp_synchronous_exit(&sp->ec[idx], x4);
 			/* Should not get here. */
 			panic();
-		} else
-			return spmc_smc_return(smc_fid, secure_origin, x1, x2, x3, x4,
-					       handle, cookie, flags, dst_id,
-					       spmc_get_sp_ffa_version(sp));
+		}
+#if SPMC_DIRECT_MSG_BATCH
+		if (batch_done != 0U) {
+			return direct_batch_return(sp, batch_done, dst_id,
+						   cookie, handle, flags);
+		}
+#endif
+		return spmc_smc_return(smc_fid, secure_origin, x1, x2, x3, x4,
+				       handle, cookie, flags, dst_id,
+				       spmc_get_sp_ffa_version(sp));
 	}
 
 	return spmc_ffa_error_return(handle, FFA_ERROR_NOT_SUPPORTED);
@@ -1659,6 +2002,12 @@ static uint64_t ffa_run_handler(uint32_t smc_fid,
 		return spmc_ffa_error_return(handle,
 					     FFA_ERROR_INVALID_PARAMETER);
 	}
+
+#if SPMC_DEFER_SP_INIT
+	if (!secure_origin) {
+		spmc_sp_deferred_init(sp);
+	}
+#endif
 	if (sp->runtime_el == S_EL0) {
 		spin_lock(&sp->rt_state_lock);
 	}
@@ -2591,6 +2940,73 @@ static int32_t sp_init(void)
 	return 1;
 }
 
+#if SPMC_DEFER_SP_INIT
+/* Serialises the deferred initialisation of the SP across cores. */
+static spinlock_t sp_deferred_init_lock;
+
+#if SPMC_DEFER_SP_LOAD
+/* Platforms that do not load the SP image from BL31 leave the SP unusable. */
+#pragma weak plat_spmc_sp_load
+int plat_spmc_sp_load(uint16_t sp_id)
+{
+	return -ENOTSUP;
+}
+#endif
+
+/*******************************************************************************
+ * Run the initialisation of a S-EL0 SP that was deferred from boot, on its
+ * first use by the Normal world. This is called while handling an SMC from the
+ * Normal world, whose EL1 system and SIMD registers are preserved around the
+ * synchronous entry into the SP. If the SP fails to initialise, its execution
+ * context is left running so that any request to it is rejected as busy, as it
+ * would be after a failure at boot.
+ *
+ * With SPMC_DEFER_SP_LOAD, the platform is first asked to load the SP image,
+ * which BL2 has left out. The SP is treated as having failed to initialise if
+ * that does not succeed.
+ ******************************************************************************/
+static void spmc_sp_deferred_init(struct secure_partition_desc *sp)
+{
+	/*
+	 * Once cleared, the flag is only read again by the callers before they
+	 * take the runtime state lock of the SP, which orders their accesses
+	 * after the initialisation.
+	 */
+	if (!sp->init_pending) {
+		return;
+	}
+
+	spin_lock(&sp_deferred_init_lock);
+
+#if SPMC_DEFER_SP_LOAD
+	if (sp->init_pending && (plat_spmc_sp_load(sp->sp_id) != 0)) {
+		ERROR("SP (0x%x) failed to load.\n", sp->sp_id);
+		spmc_get_sp_ec(sp)->rt_state = RT_STATE_RUNNING;
+		sp->init_pending = false;
+	}
+#endif
+
+	if (sp->init_pending) {
+		cm_el1_sysregs_context_save(NON_SECURE);
+#if CTX_INCLUDE_FPREGS || CTX_INCLUDE_SVE_REGS
+		simd_ctx_save(NON_SECURE, false);
+#endif
+
+		(void)sp_init();
+
+		cm_el1_sysregs_context_restore(NON_SECURE);
+#if CTX_INCLUDE_FPREGS || CTX_INCLUDE_SVE_REGS
+		simd_ctx_restore(NON_SECURE);
+#endif
+		cm_set_next_eret_context(NON_SECURE);
+
+		sp->init_pending = false;
+	}
+
+	spin_unlock(&sp_deferred_init_lock);
+}
+#endif /* SPMC_DEFER_SP_INIT */
+
 static void initalize_sp_descs(void)
 {
 	struct secure_partition_desc *sp;
@@ -2657,6 +3073,7 @@ int32_t spmc_setup(void)
 		return ret;
 	}
 	memset(spmc_shmem_obj_state.data, 0, spmc_shmem_obj_state.data_size);
+	spmc_shmem_obj_state_init(&spmc_shmem_obj_state);
 
 	/* Setup logical SPs. */
 	ret = logical_sp_init();
@@ -2698,7 +3115,20 @@ int32_t spmc_setup(void)
 	}
 
 	/* Register init function for deferred init.  */
+#if SPMC_DEFER_SP_INIT
+	/*
+	 * A UP S-EL0 SP can be initialised on any core, so let its first use
+	 * by the Normal world do it rather than delay the entry into BL33.
+	 */
+	if (spmc_get_current_sp_ctx()->runtime_el == S_EL0) {
+		spmc_get_current_sp_ctx()->init_pending = true;
+		INFO("Secure Partition init deferred to its first use.\n");
+	} else {
+		bl31_register_bl32_init(&sp_init);
+	}
+#else
 	bl31_register_bl32_init(&sp_init);
+#endif
 
 	INFO("Secure Partition setup done.\n");
 
@@ -2762,6 +3192,13 @@ uint64_t spmc_smc_handler(uint32_t smc_fid,
 		return direct_resp_smc_handler(smc_fid, secure_origin, x1, x2,
 					       x3, x4, cookie, handle, flags);
 
+#if SPMC_DIRECT_MSG_BATCH
+	case SPMC_DIRECT_REQ_BATCH_SMC64:
+		return direct_req_batch_smc_handler(smc_fid, secure_origin, x1,
+						    x2, x3, x4, cookie, handle,
+						    flags);
+#endif
+
 	case FFA_RXTX_MAP_SMC32:
 	case FFA_RXTX_MAP_SMC64:
 		return rxtx_map_handler(smc_fid, secure_origin, x1, x2, x3, x4,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2022-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -123,6 +123,13 @@ static int32_t spmc_send_pm_msg(uint8_t pm_msg_type,
 	u_register_t resp;
 	uint64_t rc;
 
+#if SPMC_DEFER_SP_INIT
+	/* The SP has nothing to act upon before it is initialised. */
+	if (sp->init_pending) {
+		return 0;
+	}
+#endif
+
 	/* Obtain a reference to the SP execution context. */
 	ec = spmc_get_sp_ec(sp);
 
@@ -52,6 +52,31 @@ struct spmc_shmem_obj_state spmc_shmem_obj_state = {
 	.next_handle = 0xffffffc0U,
 };
 
+/*
+ * Objects are allocated as runs of contiguous blocks of the datastore, so that
+ * freeing an object never moves the others.
+ */
+#define SPMC_SHMEM_BLOCK_SIZE		U(64)
+#define SPMC_SHMEM_BITMAP_BITS		U(64)
+
+/* Multiplier of the Fibonacci hash used to index objects by handle */
+#define SPMC_SHMEM_INDEX_HASH_MUL	ULL(0x9E3779B97F4A7C15)
+
+/**
+ * spmc_shmem_obj_lock - Get the lock protecting an object.
+ * @handle:     Handle of the object.
+ *
+ * Handles are allocated sequentially, so consecutive transactions use
+ * different locks. The locks are taken after the mailbox lock of the caller
+ * and before spmc_shmem_obj_state.lock.
+ *
+ * Return: Lock to hold while accessing the object with handle @handle.
+ */
+static spinlock_t *spmc_shmem_obj_lock(uint64_t handle)
+{
+	return &spmc_shmem_obj_state.obj_lock[handle % SPMC_SHMEM_OBJ_LOCKS];
+}
+
 /**
  * spmc_shmem_obj_size - Convert from descriptor size to object size.
  * @desc_size:  Size of struct ffa_memory_region_descriptor object.
@@ -63,6 +88,220 @@ static size_t spmc_shmem_obj_size(size_t desc_size)
 	return desc_size + offsetof(struct spmc_shmem_obj, desc);
 }
 
+/**
+ * spmc_shmem_obj_blocks - Number of blocks used by an object.
+ * @obj_size:   Size of struct spmc_shmem_obj object.
+ *
+ * The whole struct spmc_shmem_obj is always covered, as it is written on
+ * allocation even if the descriptor is smaller than struct ffa_mtd.
+ *
+ * Return: Number of blocks needed to store an object of @obj_size bytes.
+ */
+static size_t spmc_shmem_obj_blocks(size_t obj_size)
+{
+	size_t size = MAX(obj_size, sizeof(struct spmc_shmem_obj));
+
+	return (size + SPMC_SHMEM_BLOCK_SIZE - 1U) / SPMC_SHMEM_BLOCK_SIZE;
+}
+
+static struct spmc_shmem_obj *
+spmc_shmem_block_to_obj(struct spmc_shmem_obj_state *state, size_t block)
+{
+	return (struct spmc_shmem_obj *)(state->blocks +
+					 (block * SPMC_SHMEM_BLOCK_SIZE));
+}
+
+static size_t spmc_shmem_obj_to_block(struct spmc_shmem_obj_state *state,
+				      const struct spmc_shmem_obj *obj)
+{
+	return ((uintptr_t)obj - (uintptr_t)state->blocks) /
+	       SPMC_SHMEM_BLOCK_SIZE;
+}
+
+static bool spmc_shmem_block_is_used(const struct spmc_shmem_obj_state *state,
+				     size_t block)
+{
+	return ((state->block_used[block / SPMC_SHMEM_BITMAP_BITS] >>
+		 (block % SPMC_SHMEM_BITMAP_BITS)) & 1U) != 0U;
+}
+
+static void spmc_shmem_blocks_mark(struct spmc_shmem_obj_state *state,
+				   size_t first, size_t count, bool used)
+{
+	for (size_t block = first; block < (first + count); block++) {
+		uint64_t bit = ULL(1) << (block % SPMC_SHMEM_BITMAP_BITS);
+
+		if (used) {
+			state->block_used[block / SPMC_SHMEM_BITMAP_BITS] |= bit;
+		} else {
+			state->block_used[block / SPMC_SHMEM_BITMAP_BITS] &= ~bit;
+		}
+	}
+}
+
+/**
+ * spmc_shmem_blocks_find_free - Find a run of free blocks.
+ * @state:      Global state.
+ * @count:      Number of contiguous blocks needed.
+ *
+ * Return: Index of the first block of the lowest run of @count free blocks,
+ *         or @state->block_count if there is none.
+ */
+static size_t spmc_shmem_blocks_find_free(const struct spmc_shmem_obj_state *state,
+					  size_t count)
+{
+	size_t start = 0U;
+	size_t block = 0U;
+
+	while (block < state->block_count) {
+		uint64_t word = state->block_used[block / SPMC_SHMEM_BITMAP_BITS];
+
+		/* Skip whole words at once when possible */
+		if ((block % SPMC_SHMEM_BITMAP_BITS) == 0U) {
+			if (word == ~ULL(0)) {
+				block += SPMC_SHMEM_BITMAP_BITS;
+				start = block;
+				continue;
+			}
+			if ((word == 0U) &&
+			    ((block + SPMC_SHMEM_BITMAP_BITS - start) < count)) {
+				block += SPMC_SHMEM_BITMAP_BITS;
+				continue;
+			}
+		}
+
+		if (spmc_shmem_block_is_used(state, block)) {
+			start = block + 1U;
+		} else if ((block + 1U - start) == count) {
+			return start;
+		}
+		block++;
+	}
+
+	return state->block_count;
+}
+
+static size_t spmc_shmem_index_hash(const struct spmc_shmem_obj_state *state,
+				    uint64_t handle)
+{
+	return (size_t)((handle * SPMC_SHMEM_INDEX_HASH_MUL) >> 32) &
+	       state->index_mask;
+}
+
+/**
+ * spmc_shmem_obj_index_add - Make an object findable by its handle.
+ * @state:      Global state.
+ * @obj:        Object whose handle has been set.
+ *
+ * The index always has more entries than there are blocks, so it cannot be
+ * full.
+ */
+static void spmc_shmem_obj_index_add(struct spmc_shmem_obj_state *state,
+				     struct spmc_shmem_obj *obj)
+{
+	size_t slot = spmc_shmem_index_hash(state, obj->desc.handle);
+
+	while (state->index[slot] != 0U) {
+		slot = (slot + 1U) & state->index_mask;
+	}
+
+	state->index[slot] = (uint32_t)spmc_shmem_obj_to_block(state, obj) + 1U;
+}
+
+/**
+ * spmc_shmem_obj_index_remove - Remove an object from the handle index.
+ * @state:      Global state.
+ * @obj:        Object to remove, nothing is done if it is not in the index.
+ *
+ * The following entries of the probe sequence are moved back, so that lookups
+ * never need to step over removed entries.
+ */
+static void spmc_shmem_obj_index_remove(struct spmc_shmem_obj_state *state,
+					struct spmc_shmem_obj *obj)
+{
+	uint32_t entry = (uint32_t)spmc_shmem_obj_to_block(state, obj) + 1U;
+	size_t slot = spmc_shmem_index_hash(state, obj->desc.handle);
+	size_t next;
+
+	while (state->index[slot] != entry) {
+		if (state->index[slot] == 0U) {
+			return;
+		}
+		slot = (slot + 1U) & state->index_mask;
+	}
+
+	next = slot;
+	for (;;) {
+		struct spmc_shmem_obj *next_obj;
+		size_t home;
+
+		state->index[slot] = 0U;
+
+		do {
+			next = (next + 1U) & state->index_mask;
+			if (state->index[next] == 0U) {
+				return;
+			}
+			next_obj = spmc_shmem_block_to_obj(state,
+							   state->index[next] - 1U);
+			home = spmc_shmem_index_hash(state,
+						     next_obj->desc.handle);
+			/* Keep the entry if @slot is not on its probe path */
+		} while (((next - home) & state->index_mask) <
+			 ((next - slot) & state->index_mask));
+
+		state->index[slot] = state->index[next];
+		slot = next;
+	}
+}
+
+/**
+ * spmc_shmem_obj_state_init - Set up the allocator in the datastore.
+ * @state:      Global state, with @data and @data_size set and @data zeroed.
+ *
+ * The block bitmap and the handle index are placed at the start of the
+ * datastore, the rest is divided into blocks.
+ */
+void spmc_shmem_obj_state_init(struct spmc_shmem_obj_state *state)
+{
+	uintptr_t data_end = (uintptr_t)state->data + state->data_size;
+	size_t block_count = state->data_size / SPMC_SHMEM_BLOCK_SIZE;
+	size_t bitmap_words, index_size;
+	uintptr_t blocks;
+
+	/* Shrink the blocks until the metadata fits in front of them */
+	for (;;) {
+		bitmap_words = (block_count + SPMC_SHMEM_BITMAP_BITS - 1U) /
+			       SPMC_SHMEM_BITMAP_BITS;
+		index_size = 1U;
+		while (index_size <= block_count) {
+			index_size <<= 1U;
+		}
+		blocks = round_up((uintptr_t)state->data +
+				  (bitmap_words * sizeof(uint64_t)) +
+				  (index_size * sizeof(uint32_t)),
+				  SPMC_SHMEM_BLOCK_SIZE);
+		if ((block_count == 0U) ||
+		    ((blocks + (block_count * SPMC_SHMEM_BLOCK_SIZE)) <= data_end)) {
+			break;
+		}
+		block_count--;
+	}
+
+	state->block_used = (uint64_t *)state->data;
+	state->index = (uint32_t *)&state->block_used[bitmap_words];
+	state->index_mask = index_size - 1U;
+	state->blocks = (uint8_t *)blocks;
+	state->block_count = block_count;
+	state->allocated = 0U;
+
+	/* Blocks past the end in the last bitmap word are never free */
+	if ((block_count % SPMC_SHMEM_BITMAP_BITS) != 0U) {
+		state->block_used[bitmap_words - 1U] =
+			~((ULL(1) << (block_count % SPMC_SHMEM_BITMAP_BITS)) - 1U);
+	}
+}
+
 /**
  * spmc_shmem_obj_alloc - Allocate struct spmc_shmem_obj.
  * @state:      Global state.
@@ -70,16 +309,13 @@ static size_t spmc_shmem_obj_size(size_t desc_size)
  *              allocated object will hold.
  *
  * Return: Pointer to newly allocated object, or %NULL if there not enough space
- *         left. The returned pointer is only valid while @state is locked, to
- *         used it again after unlocking @state, spmc_shmem_obj_lookup must be
- *         called.
+ *         left.
  */
 static struct spmc_shmem_obj *
 spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 {
 	struct spmc_shmem_obj *obj;
-	size_t free = state->data_size - state->allocated;
-	size_t obj_size;
+	size_t obj_size, count, first;
 
 	if (state->data == NULL) {
 		ERROR("Missing shmem datastore!\n");
@@ -102,46 +338,92 @@ spmc_shmem_obj_alloc(struct spmc_shmem_obj_state *state, size_t desc_size)
 		return NULL;
 	}
 
-	if (obj_size > free) {
+	count = spmc_shmem_obj_blocks(obj_size);
+
+	spin_lock(&state->lock);
+	if (count > state->block_count) {
+		first = state->block_count;
+	} else {
+		first = spmc_shmem_blocks_find_free(state, count);
+	}
+
+	if (first == state->block_count) {
 		WARN("%s(0x%zx) failed, free 0x%zx\n",
-		     __func__, desc_size, free);
+		     __func__, desc_size,
+		     (state->block_count * SPMC_SHMEM_BLOCK_SIZE) -
+		     state->allocated);
+		spin_unlock(&state->lock);
 		return NULL;
 	}
-	obj = (struct spmc_shmem_obj *)(state->data + state->allocated);
+
+	spmc_shmem_blocks_mark(state, first, count, true);
+	state->allocated += count * SPMC_SHMEM_BLOCK_SIZE;
+	spin_unlock(&state->lock);
+
+	obj = spmc_shmem_block_to_obj(state, first);
 	obj->desc = (struct ffa_mtd) {0};
 	obj->desc_size = desc_size;
 	obj->desc_filled = 0;
 	obj->in_use = 0;
 	obj->hyp_shift = 0;
-	state->allocated += obj_size;
 	return obj;
 }
 
 /**
- * spmc_shmem_obj_free - Free struct spmc_shmem_obj.
+ * spmc_shmem_obj_new_handle - Reserve a handle for a new object.
  * @state:      Global state.
- * @obj:        Object to free.
  *
- * Release memory used by @obj. Other objects may move, so on return all
- * pointers to struct spmc_shmem_obj object should be considered invalid, not
- * just @obj.
+ * Return: Handle that no other object uses.
+ */
+static uint64_t spmc_shmem_obj_new_handle(struct spmc_shmem_obj_state *state)
+{
+	uint64_t handle;
+
+	spin_lock(&state->lock);
+	handle = state->next_handle++;
+	spin_unlock(&state->lock);
+
+	return handle;
+}
+
+/**
+ * spmc_shmem_obj_set_handle - Assign a handle to an object.
+ * @state:      Global state.
+ * @obj:        Object to assign a handle to.
+ * @handle:     Handle returned by spmc_shmem_obj_new_handle.
  *
- * The current implementation always compacts the remaining objects to simplify
- * the allocator and to avoid fragmentation.
+ * The object can then be found with spmc_shmem_obj_lookup until it is freed.
+ * The caller must hold the lock of @handle.
  */
+static void spmc_shmem_obj_set_handle(struct spmc_shmem_obj_state *state,
+				      struct spmc_shmem_obj *obj,
+				      uint64_t handle)
+{
+	obj->desc.handle = handle;
+
+	spin_lock(&state->lock);
+	spmc_shmem_obj_index_add(state, obj);
+	spin_unlock(&state->lock);
+}
 
+/**
+ * spmc_shmem_obj_free - Free struct spmc_shmem_obj.
+ * @state:      Global state.
+ * @obj:        Object to free.
+ *
+ * Release the blocks used by @obj. Other objects are not affected.
+ */
 static void spmc_shmem_obj_free(struct spmc_shmem_obj_state *state,
 				  struct spmc_shmem_obj *obj)
 {
-	size_t free_size = spmc_shmem_obj_size(obj->desc_size);
-	uint8_t *shift_dest = (uint8_t *)obj;
-	uint8_t *shift_src = shift_dest + free_size;
-	size_t shift_size = state->allocated - (shift_src - state->data);
-
-	if (shift_size != 0U) {
-		memmove(shift_dest, shift_src, shift_size);
-	}
-	state->allocated -= free_size;
+	size_t count = spmc_shmem_obj_blocks(spmc_shmem_obj_size(obj->desc_size));
+
+	spin_lock(&state->lock);
+	spmc_shmem_obj_index_remove(state, obj);
+	spmc_shmem_blocks_mark(state, spmc_shmem_obj_to_block(state, obj),
+			       count, false);
+	state->allocated -= count * SPMC_SHMEM_BLOCK_SIZE;
+	spin_unlock(&state->lock);
 }
 
 /**
@@ -149,23 +431,37 @@ static void spmc_shmem_obj_free(struct spmc_shmem_obj_state *state,
  * @state:      Global state.
  * @handle:     Unique handle of object to return.
  *
+ * The caller must hold the lock of @handle, which keeps the returned object
+ * from being freed.
+ *
  * Return: struct spmc_shmem_obj_state object with handle matching @handle.
  *         %NULL, if not object in @state->data has a matching handle.
  */
 static struct spmc_shmem_obj *
 spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
 {
-	uint8_t *curr = state->data;
+	struct spmc_shmem_obj *found = NULL;
+	size_t slot;
 
-	while (curr - state->data < state->allocated) {
-		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
+	if (state->index == NULL) {
+		return NULL;
+	}
+
+	spin_lock(&state->lock);
+	slot = spmc_shmem_index_hash(state, handle);
+	while (state->index[slot] != 0U) {
+		struct spmc_shmem_obj *obj =
+			spmc_shmem_block_to_obj(state, state->index[slot] - 1U);
 
 		if (obj->desc.handle == handle) {
-			return obj;
+			found = obj;
+			break;
 		}
-		curr += spmc_shmem_obj_size(obj->desc_size);
+		slot = (slot + 1U) & state->index_mask;
 	}
-	return NULL;
+	spin_unlock(&state->lock);
+
+	return found;
 }
 
 /**
@@ -173,6 +469,9 @@ spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
  * @offset:     Offset used to track which objects have previously been
  *              returned.
  *
+ * Only objects that have been assigned a handle are returned, temporary
+ * objects used by other cores are skipped. The caller must hold @state->lock.
+ *
  * Return: the next struct spmc_shmem_obj_state object from the provided
  *	   offset.
  *	   %NULL, if there are no more objects.
@@ -180,14 +479,18 @@ spmc_shmem_obj_lookup(struct spmc_shmem_obj_state *state, uint64_t handle)
 static struct spmc_shmem_obj *
 spmc_shmem_obj_get_next(struct spmc_shmem_obj_state *state, size_t *offset)
 {
-	uint8_t *curr = state->data + *offset;
-
-	if (curr - state->data < state->allocated) {
-		struct spmc_shmem_obj *obj = (struct spmc_shmem_obj *)curr;
+	if (state->index == NULL) {
+		return NULL;
+	}
 
-		*offset += spmc_shmem_obj_size(obj->desc_size);
+	/* @offset is the next entry of the handle index to look at. */
+	while (*offset <= state->index_mask) {
+		uint32_t entry = state->index[*offset];
 
-		return obj;
+		(*offset)++;
+		if (entry != 0U) {
+			return spmc_shmem_block_to_obj(state, entry - 1U);
+		}
 	}
 	return NULL;
 }
@@ -671,8 +974,6 @@ spmc_shm_convert_mtd_to_v1_0(struct spmc_shmem_obj *out_obj,
  *                  descriptor.
  *
  * Return: 0 if conversion and population succeeded.
- * Note: This function invalidates the reference to @orig therefore
- * `spmc_shmem_obj_lookup` must be called if further usage is required.
  */
 static uint32_t
 spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
@@ -713,11 +1014,7 @@ spmc_populate_ffa_v1_0_descriptor(void *dst, struct spmc_shmem_obj *orig_obj,
 		*copy_size = MIN(v1_0_obj->desc_size - offset, buf_size);
 		memcpy(dst, (uint8_t *) &v1_0_obj->desc + offset, *copy_size);
 
-		/*
-		 * We're finished with the v1.0 descriptor for now so free it.
-		 * Note that this will invalidate any references to the v1.1
-		 * descriptor.
-		 */
+		/* We're finished with the v1.0 descriptor for now so free it. */
 		spmc_shmem_obj_free(&spmc_shmem_obj_state, v1_0_obj);
 
 		return 0;
@@ -1021,6 +1318,13 @@ static int spmc_shmem_check_state_obj(struct spmc_shmem_obj *obj,
 		return FFA_ERROR_INVALID_PARAMETER;
 	}
 
+	/*
+	 * The memory regions of the other objects are only written by senders,
+	 * which are serialized by the mailbox lock held by the caller. Holding
+	 * the state lock keeps them from being freed while they are compared.
+	 */
+	spin_lock(&spmc_shmem_obj_state.lock);
+
 	inflight_obj = spmc_shmem_obj_get_next(&spmc_shmem_obj_state,
 					       &obj_offset);
 
@@ -1033,11 +1337,10 @@ static int spmc_shmem_check_state_obj(struct spmc_shmem_obj *obj,
 		    (obj->desc_size == obj->desc_filled)) {
 			other_mrd = spmc_shmem_obj_get_comp_mrd(inflight_obj,
 							  FFA_VERSION_COMPILED);
-			if (other_mrd == NULL) {
-				return FFA_ERROR_INVALID_PARAMETER;
-			}
-			if (overlapping_memory_regions(requested_mrd,
+			if ((other_mrd == NULL) ||
+			    overlapping_memory_regions(requested_mrd,
 						       other_mrd)) {
+				spin_unlock(&spmc_shmem_obj_state.lock);
 				return FFA_ERROR_INVALID_PARAMETER;
 			}
 		}
@@ -1045,11 +1348,14 @@ static int spmc_shmem_check_state_obj(struct spmc_shmem_obj *obj,
 		inflight_obj = spmc_shmem_obj_get_next(&spmc_shmem_obj_state,
 						       &obj_offset);
 	}
+
+	spin_unlock(&spmc_shmem_obj_state.lock);
 	return 0;
 }
 
 static long spmc_ffa_fill_desc(struct mailbox *mbox,
 			       struct spmc_shmem_obj *obj,
+			       uint64_t mem_handle,
 			       uint32_t fragment_length,
 			       ffa_mtd_flag32_t mtd_flag,
 			       uint32_t ffa_version,
@@ -1131,7 +1437,8 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 			goto err_bad_desc;
 		}
 
-		obj->desc.handle = spmc_shmem_obj_state.next_handle++;
+		spmc_shmem_obj_set_handle(&spmc_shmem_obj_state, obj,
+					  mem_handle);
 		obj->desc.flags |= mtd_flag;
 	}
 
@@ -1165,7 +1472,6 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 	 */
 	if (ffa_version == MAKE_FFA_VERSION(1, 0)) {
 		struct spmc_shmem_obj *v1_1_obj;
-		uint64_t mem_handle;
 
 		/* Calculate the size that the v1.1 descriptor will required. */
 		uint64_t v1_1_desc_size =
@@ -1197,17 +1503,13 @@ static long spmc_ffa_fill_desc(struct mailbox *mbox,
 
 		/*
 		 * We're finished with the v1.0 descriptor so free it
-		 * and continue our checks with the new v1.1 descriptor.
+		 * and continue our checks with the new v1.1 descriptor,
+		 * which takes over its handle.
 		 */
-		mem_handle = obj->desc.handle;
 		spmc_shmem_obj_free(&spmc_shmem_obj_state, obj);
-		obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
-		if (obj == NULL) {
-			ERROR("%s: Failed to find converted descriptor.\n",
-			     __func__);
-			ret = FFA_ERROR_INVALID_PARAMETER;
-			return spmc_ffa_error_return(smc_handle, ret);
-		}
+		obj = v1_1_obj;
+		spmc_shmem_obj_set_handle(&spmc_shmem_obj_state, obj,
+					  mem_handle);
 	}
 
 	/* Allow for platform specific operations to be performed. */
@@ -1256,6 +1558,8 @@ long spmc_ffa_mem_send(uint32_t smc_fid,
 	long ret;
 	struct spmc_shmem_obj *obj;
 	struct mailbox *mbox = spmc_get_mbox_desc(secure_origin);
+	spinlock_t *obj_lock;
+	uint64_t mem_handle;
 	ffa_mtd_flag32_t mtd_flag;
 	uint32_t ffa_version = get_partition_ffa_version(secure_origin);
 	size_t min_desc_size;
@@ -1301,23 +1605,38 @@ long spmc_ffa_mem_send(uint32_t smc_fid,
 					     FFA_ERROR_INVALID_PARAMETER);
 	}
 
-	spin_lock(&spmc_shmem_obj_state.lock);
+	/*
+	 * All the NS senders share the single NS TX buffer, which the
+	 * descriptor is copied from, so concurrent FFA_MEM_SHARE/LEND calls are
+	 * serialized on its lock. The overlap check then walks all the objects
+	 * under spmc_shmem_obj_state.lock. Only the retrieves and relinquishes
+	 * of the SPs, which use their own mailboxes, and the reclaims run
+	 * concurrently with them.
+	 */
+	spin_lock(&mbox->lock);
 	obj = spmc_shmem_obj_alloc(&spmc_shmem_obj_state, total_length);
 	if (obj == NULL) {
 		ret = FFA_ERROR_NO_MEMORY;
 		goto err_unlock;
 	}
 
-	spin_lock(&mbox->lock);
-	ret = spmc_ffa_fill_desc(mbox, obj, fragment_length, mtd_flag,
-				 ffa_version, handle);
-	spin_unlock(&mbox->lock);
+	/*
+	 * Reserve the handle now so that its lock is held before the object
+	 * can be looked up from other cores.
+	 */
+	mem_handle = spmc_shmem_obj_new_handle(&spmc_shmem_obj_state);
+	obj_lock = spmc_shmem_obj_lock(mem_handle);
 
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_lock(obj_lock);
+	ret = spmc_ffa_fill_desc(mbox, obj, mem_handle, fragment_length,
+				 mtd_flag, ffa_version, handle);
+	spin_unlock(obj_lock);
+
+	spin_unlock(&mbox->lock);
 	return ret;
 
 err_unlock:
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(&mbox->lock);
 	return spmc_ffa_error_return(handle, ret);
 }
 
@@ -1350,8 +1669,10 @@ long spmc_ffa_mem_frag_tx(uint32_t smc_fid,
 
 	struct spmc_shmem_obj *obj;
 	uint64_t mem_handle = handle_low | (((uint64_t)handle_high) << 32);
+	spinlock_t *obj_lock = spmc_shmem_obj_lock(mem_handle);
 
-	spin_lock(&spmc_shmem_obj_state.lock);
+	spin_lock(&mbox->lock);
+	spin_lock(obj_lock);
 
 	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
 	if (obj == NULL) {
@@ -1376,16 +1697,16 @@ long spmc_ffa_mem_frag_tx(uint32_t smc_fid,
 		goto err_unlock;
 	}
 
-	spin_lock(&mbox->lock);
-	ret = spmc_ffa_fill_desc(mbox, obj, fragment_length, 0, ffa_version,
-				 handle);
-	spin_unlock(&mbox->lock);
+	ret = spmc_ffa_fill_desc(mbox, obj, mem_handle, fragment_length, 0,
+				 ffa_version, handle);
 
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
+	spin_unlock(&mbox->lock);
 	return ret;
 
 err_unlock:
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
+	spin_unlock(&mbox->lock);
 	return spmc_ffa_error_return(handle, ret);
 }
 
@@ -1560,7 +1881,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 	const struct ffa_mtd *req;
 	struct spmc_shmem_obj *obj = NULL;
 	struct spmc_shmem_obj *req_snapshot = NULL;
-	uint64_t mem_handle;
+	spinlock_t *obj_lock;
 	bool req_has_emads;
 	struct mailbox *mbox = spmc_get_mbox_desc(secure_origin);
 	uint32_t ffa_version = get_partition_ffa_version(secure_origin);
@@ -1615,8 +1936,6 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 		goto err_unlock_mailbox;
 	}
 
-	spin_lock(&spmc_shmem_obj_state.lock);
-
 	/*
 	 * Snapshot the request before validation so later reads don't depend on
 	 * mutable caller-owned TX buffer contents using memory from the shmem
@@ -1626,7 +1945,7 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 					    round_up(total_length, 16));
 	if (req_snapshot == NULL) {
 		ret = FFA_ERROR_NO_MEMORY;
-		goto err_unlock_all;
+		goto err_unlock_mailbox;
 	}
 	memcpy(&req_snapshot->desc, mbox->tx_buffer, total_length);
 	req = &req_snapshot->desc;
@@ -1643,9 +1962,12 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 		WARN("%s: unsupported attribute desc count %u.\n",
 		     __func__, req->emad_count);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
+		goto err_free_snapshot;
 	}
 
+	obj_lock = spmc_shmem_obj_lock(req->handle);
+	spin_lock(obj_lock);
+
 	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, req->handle);
 	if (obj == NULL) {
 		ret = FFA_ERROR_INVALID_PARAMETER;
@@ -1786,23 +2108,14 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 	}
 
 	/*
-	 * The request has now been fully validated and only its handle and whether
-	 * it contains EMADs are needed below. Release the snapshot before building
-	 * the response so it does not overlap with any temporary descriptor needed
+	 * The request has now been fully validated and only whether it contains
+	 * EMADs is needed below. Release the snapshot before building the
+	 * response so its space can be used by any temporary descriptor needed
 	 * for FF-A version conversion.
-	 *
-	 * Freeing an object can move every later object in the datastore, so look
-	 * the transaction object up again before using it.
 	 */
-	mem_handle = req->handle;
 	req_has_emads = req->emad_count != 0U;
 	spmc_shmem_obj_free(&spmc_shmem_obj_state, req_snapshot);
 	req_snapshot = NULL;
-	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
-	if (obj == NULL) {
-		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
-	}
 
 	/*
 	 * If the caller is v1.0 convert the descriptor, otherwise copy
@@ -1843,32 +2156,24 @@ spmc_ffa_mem_retrieve_req(uint32_t smc_fid,
 	/* Update the NS bit in the response if applicable. */
 	spmc_ffa_mem_retrieve_update_ns_bit(resp, sp_ctx, secure_origin);
 
-	/*
-	 * Response conversion may allocate and free a temporary object, which can
-	 * invalidate datastore pointers. Reacquire the transaction object before
-	 * committing its state, and only commit after response generation succeeds.
-	 */
-	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
-	if (obj == NULL) {
-		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_all;
-	}
+	/* Only commit the state once response generation has succeeded. */
 	if (req_has_emads) {
 		obj->in_use++;
 	}
 	mbox->state = MAILBOX_STATE_FULL;
 
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
 	spin_unlock(&mbox->lock);
 
 	SMC_RET8(handle, FFA_MEM_RETRIEVE_RESP, out_desc_size,
 		 copy_size, 0, 0, 0, 0, 0);
 
 err_unlock_all:
+	spin_unlock(obj_lock);
+err_free_snapshot:
 	if (req_snapshot != NULL) {
 		spmc_shmem_obj_free(&spmc_shmem_obj_state, req_snapshot);
 	}
-	spin_unlock(&spmc_shmem_obj_state.lock);
 err_unlock_mailbox:
 	spin_unlock(&mbox->lock);
 	return spmc_ffa_error_return(handle, ret);
@@ -1905,18 +2210,20 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 	uint32_t desc_sender_id;
 	struct mailbox *mbox = spmc_get_mbox_desc(secure_origin);
 	uint64_t mem_handle = handle_low | (((uint64_t)handle_high) << 32);
+	spinlock_t *obj_lock = spmc_shmem_obj_lock(mem_handle);
 	struct spmc_shmem_obj *obj;
 	uint32_t ffa_version = get_partition_ffa_version(secure_origin);
 	uint32_t actual_fragment_offset;
 
-	spin_lock(&spmc_shmem_obj_state.lock);
+	spin_lock(&mbox->lock);
+	spin_lock(obj_lock);
 
 	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
 	if (obj == NULL) {
 		WARN("%s: invalid handle, 0x%lx, not a valid handle.\n",
 		     __func__, mem_handle);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_shmem;
+		goto err_unlock_all;
 	}
 
 	desc_sender_id = (uint32_t)obj->desc.sender_id << 16;
@@ -1924,7 +2231,7 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 		WARN("%s: invalid sender_id 0x%x != 0x%x\n", __func__,
 		     sender_id, desc_sender_id);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_shmem;
+		goto err_unlock_all;
 	}
 
 	actual_fragment_offset = fragment_offset;
@@ -1937,11 +2244,9 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 		WARN("%s: invalid fragment_offset 0x%x actual 0x%x >= 0x%zx\n",
 		     __func__, fragment_offset, actual_fragment_offset, obj->desc_size);
 		ret = FFA_ERROR_INVALID_PARAMETER;
-		goto err_unlock_shmem;
+		goto err_unlock_all;
 	}
 
-	spin_lock(&mbox->lock);
-
 	if (mbox->rxtx_page_count == 0U) {
 		WARN("%s: buffer pair not registered.\n", __func__);
 		ret = FFA_ERROR_INVALID_PARAMETER;
@@ -2011,16 +2316,15 @@ long spmc_ffa_mem_frag_rx(uint32_t smc_fid,
 	mbox->last_rx_fragment_offset = fragment_offset;
 	mbox->next_rx_fragment_offset = fragment_offset + copy_size;
 
+	spin_unlock(obj_lock);
 	spin_unlock(&mbox->lock);
-	spin_unlock(&spmc_shmem_obj_state.lock);
 
 	SMC_RET8(handle, FFA_MEM_FRAG_TX, handle_low, handle_high,
 		 copy_size, sender_id, 0, 0, 0);
 
 err_unlock_all:
+	spin_unlock(obj_lock);
 	spin_unlock(&mbox->lock);
-err_unlock_shmem:
-	spin_unlock(&spmc_shmem_obj_state.lock);
 	return spmc_ffa_error_return(handle, ret);
 }
 
@@ -2049,6 +2353,8 @@ int spmc_ffa_mem_relinquish(uint32_t smc_fid,
 	struct mailbox *mbox = spmc_get_mbox_desc(secure_origin);
 	struct spmc_shmem_obj *obj;
 	const struct ffa_mem_relinquish_descriptor *req;
+	uint64_t mem_handle;
+	spinlock_t *obj_lock;
 	struct secure_partition_desc *sp_ctx = spmc_get_current_sp_ctx();
 
 	if (!secure_origin) {
@@ -2079,9 +2385,15 @@ int spmc_ffa_mem_relinquish(uint32_t smc_fid,
 		goto err_unlock_mailbox;
 	}
 
-	spin_lock(&spmc_shmem_obj_state.lock);
+	/*
+	 * Read the handle once, the caller could change it in its TX buffer
+	 * while it is being used.
+	 */
+	mem_handle = req->handle;
+	obj_lock = spmc_shmem_obj_lock(mem_handle);
+	spin_lock(obj_lock);
 
-	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, req->handle);
+	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
 	if (obj == NULL) {
 		ret = FFA_ERROR_INVALID_PARAMETER;
 		goto err_unlock_all;
@@ -2120,13 +2432,13 @@ int spmc_ffa_mem_relinquish(uint32_t smc_fid,
 	}
 	obj->in_use--;
 
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
 	spin_unlock(&mbox->lock);
 
 	SMC_RET1(handle, FFA_SUCCESS_SMC32);
 
 err_unlock_all:
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
 err_unlock_mailbox:
 	spin_unlock(&mbox->lock);
 	return spmc_ffa_error_return(handle, ret);
@@ -2158,6 +2470,7 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 	int ret;
 	struct spmc_shmem_obj *obj;
 	uint64_t mem_handle = handle_low | (((uint64_t)handle_high) << 32);
+	spinlock_t *obj_lock = spmc_shmem_obj_lock(mem_handle);
 
 	if (secure_origin) {
 		WARN("%s: unsupported reclaim direction.\n", __func__);
@@ -2171,7 +2484,7 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 					     FFA_ERROR_INVALID_PARAMETER);
 	}
 
-	spin_lock(&spmc_shmem_obj_state.lock);
+	spin_lock(obj_lock);
 
 	obj = spmc_shmem_obj_lookup(&spmc_shmem_obj_state, mem_handle);
 	if (obj == NULL) {
@@ -2197,11 +2510,11 @@ int spmc_ffa_mem_reclaim(uint32_t smc_fid,
 	}
 
 	spmc_shmem_obj_free(&spmc_shmem_obj_state, obj);
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
 
 	SMC_RET1(handle, FFA_SUCCESS_SMC32);
 
 err_unlock:
-	spin_unlock(&spmc_shmem_obj_state.lock);
+	spin_unlock(obj_lock);
 	return spmc_ffa_error_return(handle, ret);
 }
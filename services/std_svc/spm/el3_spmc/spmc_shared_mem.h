@@ -31,24 +31,46 @@ struct ffa_mem_relinquish_descriptor {
 CASSERT(sizeof(struct ffa_mem_relinquish_descriptor) == 16,
 	assert_ffa_mem_relinquish_descriptor_size_mismatch);
 
+/* Number of buckets the shared memory objects are spread over for locking */
+#define SPMC_SHMEM_OBJ_LOCKS		U(32)
+
 /**
  * struct spmc_shmem_obj_state - Global state.
  * @data:           Backing store for spmc_shmem_obj objects.
  * @data_size:      The size allocated for the backing store.
- * @allocated:      Number of bytes allocated in @data.
+ * @allocated:      Number of bytes allocated in @blocks.
  * @next_handle:    Handle used for next allocated object.
- * @lock:           Lock protecting all state in this file.
+ * @blocks:         Area of @data that objects are allocated from, as runs of
+ *                  contiguous blocks.
+ * @block_count:    Number of blocks in @blocks.
+ * @block_used:     Bitmap of the allocated blocks.
+ * @index:          Hash table of the objects with a handle, each entry holds
+ *                  the first block of an object plus one, or 0 if unused.
+ * @index_mask:     Number of entries in @index minus one.
+ * @lock:           Lock protecting the allocator, @index and @next_handle.
+ *                  It is only held for short periods by the object helpers.
+ * @obj_lock:       Locks protecting the objects whose handle falls in their
+ *                  bucket, see spmc_shmem_obj_lock(). An object can only be
+ *                  modified or freed with the lock of its bucket held.
  */
 struct spmc_shmem_obj_state {
 	uint8_t *data;
 	size_t data_size;
 	size_t allocated;
 	uint64_t next_handle;
+	uint8_t *blocks;
+	size_t block_count;
+	uint64_t *block_used;
+	uint32_t *index;
+	size_t index_mask;
 	spinlock_t lock;
+	spinlock_t obj_lock[SPMC_SHMEM_OBJ_LOCKS];
 };
 
 extern struct spmc_shmem_obj_state spmc_shmem_obj_state;
 
+void spmc_shmem_obj_state_init(struct spmc_shmem_obj_state *state);
+
 bool spmc_compatible_version(uint32_t ffa_version, uint16_t major,
 			     uint16_t minor);
 
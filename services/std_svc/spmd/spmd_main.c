@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020-2025, Arm Limited and Contributors. All rights reserved.
+ * Copyright (c) 2020-2026, Arm Limited and Contributors. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -834,8 +834,8 @@ uint64_t spmd_smc_switch_state(uint32_t smc_fid,
 
 	/* Save incoming security state */
 #if SPMD_SPM_AT_SEL2
-	cm_el2_sysregs_context_save(secure_state_in);
 	cm_el2_sysregs_context_save_gic(secure_state_in);
+	cm_el2_sysregs_context_switch(secure_state_in, secure_state_out);
 #else
 	cm_el1_sysregs_context_save(secure_state_in);
 #if CTX_INCLUDE_FPREGS || CTX_INCLUDE_SVE_REGS
@@ -846,7 +846,6 @@ uint64_t spmd_smc_switch_state(uint32_t smc_fid,
 
 	/* Restore outgoing security state */
 #if SPMD_SPM_AT_SEL2
-	cm_el2_sysregs_context_restore(secure_state_out);
 	cm_el2_sysregs_context_restore_gic(secure_state_out);
 #else
 	cm_el1_sysregs_context_restore(secure_state_out);
@@ -38,12 +38,160 @@ static uuid_t arm_svc_uid = {
 	{0xc0, 0xfb, 0x56, 0x41, 0xf6, 0xe2}
 };
 
+/*
+ * Services implemented as part of the Standard Service. The value 0 is reserved
+ * for function IDs which are not covered by the dispatch table.
+ */
+enum std_svc_id {
+	STD_SVC_UNMAPPED = 0,
+	STD_SVC_PSCI,
+	STD_SVC_SPM_MM,
+	STD_SVC_FFA,
+	STD_SVC_SDEI,
+	STD_SVC_TRNG,
+	STD_SVC_ERRATA_ABI,
+	STD_SVC_RMMD_EL3,
+	STD_SVC_RMI,
+	STD_SVC_FIRME,
+	STD_SVC_PCI,
+	STD_SVC_DRTM,
+	STD_SVC_LFA,
+	STD_SVC_GENERIC
+};
+
+/*
+ * Number of function numbers covered by the dispatch table, for each calling
+ * convention. This includes PSCI, SDEI, SPM-MM, TRNG, FF-A and the Errata ABI,
+ * the function IDs above it are looked up by walking the services.
+ */
+#define STD_SVC_FID_MAP_ENTRIES		U(0x100)
+
+/*
+ * Service implementing each Fast SMC function ID of the Standard Service, per
+ * calling convention and function number. Populated once at boot from the
+ * is_*_fid() predicates so that hot calls find their service in constant time.
+ */
+static uint8_t std_svc_fid_map[2][STD_SVC_FID_MAP_ENTRIES];
+
+/* Find the service implementing a function ID by walking the services */
+static enum std_svc_id std_svc_find(uint32_t smc_fid)
+{
+	if (is_psci_fid(smc_fid)) {
+		return STD_SVC_PSCI;
+	}
+
+#if SPM_MM
+	if (is_spm_mm_fid(smc_fid)) {
+		return STD_SVC_SPM_MM;
+	}
+#endif
+
+#if defined(SPD_spmd)
+	if (is_ffa_fid(smc_fid)) {
+		return STD_SVC_FFA;
+	}
+#endif
+
+#if SDEI_SUPPORT
+	if (is_sdei_fid(smc_fid)) {
+		return STD_SVC_SDEI;
+	}
+#endif
+
+#if TRNG_SUPPORT
+	if (is_trng_fid(smc_fid)) {
+		return STD_SVC_TRNG;
+	}
+#endif /* TRNG_SUPPORT */
+
+#if ERRATA_ABI_SUPPORT
+	if (is_errata_fid(smc_fid)) {
+		return STD_SVC_ERRATA_ABI;
+	}
+#endif /* ERRATA_ABI_SUPPORT */
+
+#if ENABLE_RMM
+	if (is_rmmd_el3_fid(smc_fid)) {
+		return STD_SVC_RMMD_EL3;
+	}
+
+	if (is_rmi_fid(smc_fid)) {
+		return STD_SVC_RMI;
+	}
+#endif
+
+#if FIRME_SUPPORT
+	if (is_firme_fid(smc_fid)) {
+		return STD_SVC_FIRME;
+	}
+#endif
+
+#if SMC_PCI_SUPPORT
+	if (is_pci_fid(smc_fid)) {
+		return STD_SVC_PCI;
+	}
+#endif
+
+#if DRTM_SUPPORT
+	if (is_drtm_fid(smc_fid)) {
+		return STD_SVC_DRTM;
+	}
+#endif /* DRTM_SUPPORT */
+
+#if LFA_SUPPORT
+	if (is_lfa_fid(smc_fid)) {
+		return STD_SVC_LFA;
+	}
+#endif /* LFA_SUPPORT */
+
+	return STD_SVC_GENERIC;
+}
+
+/* Populate the dispatch table of the Standard Service */
+static void std_svc_fid_map_init(void)
+{
+	unsigned int cc, fnum;
+	uint32_t smc_fid;
+
+	for (cc = SMC_32; cc <= SMC_64; cc++) {
+		for (fnum = 0U; fnum < STD_SVC_FID_MAP_ENTRIES; fnum++) {
+			smc_fid = (SMC_TYPE_FAST << FUNCID_TYPE_SHIFT) |
+				  (cc << FUNCID_CC_SHIFT) |
+				  (OEN_STD_START << FUNCID_OEN_SHIFT) |
+				  (fnum << FUNCID_NUM_SHIFT);
+			std_svc_fid_map[cc][fnum] =
+				(uint8_t)std_svc_find(smc_fid);
+		}
+	}
+}
+
+/* Get the service implementing a function ID */
+static enum std_svc_id std_svc_get(uint32_t smc_fid)
+{
+	unsigned int fnum = GET_SMC_NUM(smc_fid);
+
+	/* Reserved bits and SVE hint must be clear for the table to apply */
+	if ((fnum < STD_SVC_FID_MAP_ENTRIES) &&
+	    ((smc_fid & (MASK(FUNCID_FC_RESERVED) |
+			 MASK(FUNCID_SVE_HINT))) == 0U)) {
+		uint8_t id = std_svc_fid_map[GET_SMC_CC(smc_fid)][fnum];
+
+		if (id != (uint8_t)STD_SVC_UNMAPPED) {
+			return (enum std_svc_id)id;
+		}
+	}
+
+	return std_svc_find(smc_fid);
+}
+
 /* Setup Standard Services */
 static int32_t std_svc_setup(void)
 {
 	uintptr_t svc_arg;
 	int ret = 0;
 
+	std_svc_fid_map_init();
+
 	svc_arg = get_arm_std_svc_args(PSCI_FID_MASK);
 	assert(svc_arg);
 
@@ -134,11 +282,31 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 		x4 &= UINT32_MAX;
 	}
 
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	/*
+	 * Record the time at which the SMC entered EL3 and the time at which
+	 * its service has been found, to measure the cost of the dispatch.
+	 */
+	PMF_WRITE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_ENTER_STD_SVC,
+	    PMF_NO_CACHE_MAINT,
+	    get_cpu_data(cpu_data_pmf_ts[CPU_DATA_PMF_TS0_IDX]));
+#endif
+
+	enum std_svc_id svc = std_svc_get(smc_fid);
+
+#if ENABLE_RUNTIME_INSTRUMENTATION
+	PMF_CAPTURE_TIMESTAMP(rt_instr_svc,
+	    RT_INSTR_DISPATCH_STD_SVC,
+	    PMF_NO_CACHE_MAINT);
+#endif
+
+	switch (svc) {
 	/*
 	 * Dispatch PSCI calls to PSCI SMC handler and return its return
 	 * value
 	 */
-	if (is_psci_fid(smc_fid)) {
+	case STD_SVC_PSCI: {
 		uint64_t ret;
 
 #if ENABLE_RUNTIME_INSTRUMENTATION
@@ -170,10 +338,9 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 	 * Dispatch SPM calls to SPM SMC handler and return its return
 	 * value
 	 */
-	if (is_spm_mm_fid(smc_fid)) {
+	case STD_SVC_SPM_MM:
 		return spm_mm_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
 					  handle, flags);
-	}
 #endif
 
 #if defined(SPD_spmd)
@@ -181,73 +348,65 @@ static uintptr_t std_svc_smc_handler(uint32_t smc_fid,
 	 * Dispatch FFA calls to the FFA SMC handler implemented by the SPM
 	 * dispatcher and return its return value
 	 */
-	if (is_ffa_fid(smc_fid)) {
+	case STD_SVC_FFA:
 		return spmd_ffa_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
 					    handle, flags);
-	}
 #endif
 
 #if SDEI_SUPPORT
-	if (is_sdei_fid(smc_fid)) {
+	case STD_SVC_SDEI:
 		return sdei_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
 				flags);
-	}
 #endif
 
 #if TRNG_SUPPORT
-	if (is_trng_fid(smc_fid)) {
+	case STD_SVC_TRNG:
 		return trng_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
 				flags);
-	}
 #endif /* TRNG_SUPPORT */
 
 #if ERRATA_ABI_SUPPORT
-	if (is_errata_fid(smc_fid)) {
+	case STD_SVC_ERRATA_ABI:
 		return errata_abi_smc_handler(smc_fid, x1, x2, x3, x4, cookie,
 					      handle, flags);
-	}
 #endif /* ERRATA_ABI_SUPPORT */
 
 #if ENABLE_RMM
-
-	if (is_rmmd_el3_fid(smc_fid)) {
+	case STD_SVC_RMMD_EL3:
 		return rmmd_rmm_el3_handler(smc_fid, x1, x2, x3, x4, cookie,
 					    handle, flags);
-	}
 
-	if (is_rmi_fid(smc_fid)) {
+	case STD_SVC_RMI:
 		return rmmd_rmi_handler(smc_fid, x1, x2, x3, x4, cookie,
 					handle, flags);
-	}
 #endif
 
 #if FIRME_SUPPORT
-	if (is_firme_fid(smc_fid)) {
+	case STD_SVC_FIRME:
 		return firme_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
 				     flags);
-	}
 #endif
 
 #if SMC_PCI_SUPPORT
-	if (is_pci_fid(smc_fid)) {
+	case STD_SVC_PCI:
 		return pci_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
 				       flags);
-	}
 #endif
 
 #if DRTM_SUPPORT
-	if (is_drtm_fid(smc_fid)) {
+	case STD_SVC_DRTM:
 		return drtm_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle,
 					flags);
-	}
 #endif /* DRTM_SUPPORT */
 
 #if LFA_SUPPORT
-	if (is_lfa_fid(smc_fid)) {
+	case STD_SVC_LFA:
 		return lfa_smc_handler(smc_fid, x1, x2, x3, x4, cookie, handle, flags);
-	}
 #endif /* LFA_SUPPORT */
 
+	default:
+		break;
+	}
 
 	switch (smc_fid) {
 	case ARM_STD_SVC_CALL_COUNT:
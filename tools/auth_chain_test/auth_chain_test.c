@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the verification of a TBBR chain of trust with the mbed TLS
+ * X.509 parser and crypto modules. The certificates and images are those
+ * produced by cert_create. They are verified in the order BL1 and BL2 load
+ * them: each certificate is checked with the ROTPK or with a key from a
+ * certificate verified before it, and the keys and image hashes it holds are
+ * extracted, as auth_mod does for the TBBR CoT of tbbr_cot_bl1.c and
+ * tbbr_cot_bl2.c. The test also checks that a certificate signed with another
+ * key, a corrupted signature and a corrupted image are rejected, whether the
+ * keys are kept parsed (TF_MBEDTLS_PK_CACHE_ENTRIES) or not. The benchmark
+ * measures the verification of each certificate of the chain.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cdefs.h>
+#include <drivers/auth/auth_common.h>
+#include <drivers/auth/crypto_mod.h>
+#include <drivers/auth/img_parser_mod.h>
+#include <lib/utils_def.h>
+#include <plat/common/platform.h>
+#include <tools_share/tbbr_oid.h>
+
+/* For the heap size */
+#include MBEDTLS_CONFIG_FILE
+
+/* Public keys of the TBBR CoT */
+typedef enum key_id {
+	KEY_NONE,
+	KEY_ROT,
+	KEY_TRUSTED_WORLD,
+	KEY_NON_TRUSTED_WORLD,
+	KEY_SOC_FW_CONTENT,
+	KEY_TOS_FW_CONTENT,
+	KEY_NT_FW_CONTENT,
+	KEY_COUNT
+} key_id_t;
+
+typedef struct key_ext {
+	key_id_t key;
+	const char *oid;
+} key_ext_t;
+
+typedef struct cert_desc {
+	const char *name;
+	/* Key that signs the certificate */
+	key_id_t signer;
+	/* Keys that the certificate holds */
+	key_ext_t keys[2];
+	/* Image whose hash the certificate holds */
+	const char *image;
+	const char *hash_oid;
+} cert_desc_t;
+
+typedef struct file_buf {
+	uint8_t *data;
+	size_t len;
+} file_buf_t;
+
+static const cert_desc_t chain[] = {
+	{ "tb_fw.crt", KEY_ROT, { }, "bl2.bin", TRUSTED_BOOT_FW_HASH_OID },
+	{ "trusted_key.crt", KEY_ROT,
+	  { { KEY_TRUSTED_WORLD, TRUSTED_WORLD_PK_OID },
+	    { KEY_NON_TRUSTED_WORLD, NON_TRUSTED_WORLD_PK_OID } },
+	  NULL, NULL },
+	{ "soc_fw_key.crt", KEY_TRUSTED_WORLD,
+	  { { KEY_SOC_FW_CONTENT, SOC_FW_CONTENT_CERT_PK_OID } }, NULL, NULL },
+	{ "soc_fw_content.crt", KEY_SOC_FW_CONTENT, { }, "bl31.bin",
+	  SOC_AP_FW_HASH_OID },
+	{ "tos_fw_key.crt", KEY_TRUSTED_WORLD,
+	  { { KEY_TOS_FW_CONTENT, TRUSTED_OS_FW_CONTENT_CERT_PK_OID } },
+	  NULL, NULL },
+	{ "tos_fw_content.crt", KEY_TOS_FW_CONTENT, { }, "bl32.bin",
+	  TRUSTED_OS_FW_HASH_OID },
+	{ "nt_fw_key.crt", KEY_NON_TRUSTED_WORLD,
+	  { { KEY_NT_FW_CONTENT, NON_TRUSTED_FW_CONTENT_CERT_PK_OID } },
+	  NULL, NULL },
+	{ "nt_fw_content.crt", KEY_NT_FW_CONTENT, { }, "bl33.bin",
+	  NON_TRUSTED_WORLD_BOOTLOADER_HASH_OID },
+};
+
+int auth_chain_test_verbose;
+
+const img_parser_lib_desc_t *x509_parser_lib_desc(void);
+
+static const img_parser_lib_desc_t *parser;
+static const char *cert_dir = ".";
+
+static file_buf_t certs[ARRAY_SIZE(chain)];
+static file_buf_t images[ARRAY_SIZE(chain)];
+/* The keys point into the certificates, which are kept loaded */
+static file_buf_t keys[KEY_COUNT];
+
+/* Time spent verifying each certificate and its image */
+static uint64_t cert_ns[ARRAY_SIZE(chain)];
+
+int plat_get_mbedtls_heap(void **heap_addr, size_t *heap_size)
+{
+	return get_mbedtls_heap_helper(heap_addr, heap_size);
+}
+
+/*
+ * mbedtls_init() registers an exit handler that panics, as the firmware must
+ * never exit. Leave without running it.
+ */
+static void __dead2 quit(int status)
+{
+	(void)fflush(stdout);
+	(void)fflush(stderr);
+	_exit(status);
+}
+
+static void __dead2 fail(const char *what, const char *name, int rc)
+{
+	fprintf(stderr, "FAILED: %s, %s, error %d\n", what, name, rc);
+	quit(1);
+}
+
+static void *xmalloc(size_t size)
+{
+	void *ptr = malloc(size);
+
+	if (ptr == NULL) {
+		perror("malloc");
+		quit(2);
+	}
+
+	return ptr;
+}
+
+static void load_file(const char *name, file_buf_t *buf)
+{
+	char path[1024];
+	FILE *f;
+	long len;
+
+	(void)snprintf(path, sizeof(path), "%s/%s", cert_dir, name);
+	f = fopen(path, "rb");
+	if ((f == NULL) || (fseek(f, 0L, SEEK_END) != 0) ||
+	    ((len = ftell(f)) <= 0) || (fseek(f, 0L, SEEK_SET) != 0)) {
+		perror(path);
+		quit(2);
+	}
+
+	buf->len = (size_t)len;
+	buf->data = xmalloc(buf->len);
+	if (fread(buf->data, 1U, buf->len, f) != buf->len) {
+		perror(path);
+		quit(2);
+	}
+	(void)fclose(f);
+}
+
+static void copy_file(const file_buf_t *from, file_buf_t *to)
+{
+	to->len = from->len;
+	to->data = xmalloc(to->len);
+	memcpy(to->data, from->data, to->len);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static int get_param(auth_param_type_t type, const char *oid,
+		     const file_buf_t *cert, void **param,
+		     unsigned int *param_len)
+{
+	auth_param_type_desc_t desc = AUTH_PARAM_TYPE_DESC(type, oid);
+
+	return parser->get_auth_param(&desc, cert->data,
+				      (unsigned int)cert->len, param,
+				      param_len);
+}
+
+/*
+ * Verify a certificate with the key 'signer', extract the keys that it holds
+ * and check the hash of its image. Return 0 on success, or the error code of
+ * the failed step, which is stored in 'step'.
+ */
+static int verify_cert(const cert_desc_t *desc, const file_buf_t *cert,
+		       key_id_t signer, const file_buf_t *image,
+		       const char **step)
+{
+	void *data, *sig, *sig_alg, *param;
+	unsigned int data_len, sig_len, sig_alg_len, param_len;
+	int rc;
+
+	*step = "certificate format";
+	rc = parser->check_integrity(cert->data, (unsigned int)cert->len);
+	if (rc != IMG_PARSER_OK) {
+		return rc;
+	}
+
+	*step = "certificate parameters";
+	rc = get_param(AUTH_PARAM_RAW_DATA, NULL, cert, &data, &data_len);
+	if (rc == IMG_PARSER_OK) {
+		rc = get_param(AUTH_PARAM_SIG, NULL, cert, &sig, &sig_len);
+	}
+	if (rc == IMG_PARSER_OK) {
+		rc = get_param(AUTH_PARAM_SIG_ALG, NULL, cert, &sig_alg,
+			       &sig_alg_len);
+	}
+	if (rc != IMG_PARSER_OK) {
+		return rc;
+	}
+
+	*step = "signature";
+	rc = crypto_mod_verify_signature(data, data_len, sig, sig_len,
+					 sig_alg, sig_alg_len,
+					 keys[signer].data,
+					 (unsigned int)keys[signer].len);
+	if (rc != CRYPTO_SUCCESS) {
+		return rc;
+	}
+
+	*step = "public key";
+	for (size_t i = 0U; i < ARRAY_SIZE(desc->keys); i++) {
+		if (desc->keys[i].key == KEY_NONE) {
+			continue;
+		}
+		rc = get_param(AUTH_PARAM_PUB_KEY, desc->keys[i].oid, cert,
+			       &param, &param_len);
+		if (rc != IMG_PARSER_OK) {
+			return rc;
+		}
+		keys[desc->keys[i].key].data = param;
+		keys[desc->keys[i].key].len = param_len;
+	}
+
+	if (desc->image == NULL) {
+		return 0;
+	}
+
+	*step = "image hash";
+	rc = get_param(AUTH_PARAM_HASH, desc->hash_oid, cert, &param,
+		       &param_len);
+	if (rc != IMG_PARSER_OK) {
+		return rc;
+	}
+
+	return crypto_mod_verify_hash(image->data, (unsigned int)image->len,
+				      param, param_len);
+}
+
+/* Verify the whole chain, as on each boot */
+static void verify_chain(void)
+{
+	const char *step;
+	uint64_t t0;
+	int rc;
+
+	for (size_t i = 0U; i < ARRAY_SIZE(chain); i++) {
+		t0 = now_ns();
+		rc = verify_cert(&chain[i], &certs[i], chain[i].signer,
+				 &images[i], &step);
+		cert_ns[i] += now_ns() - t0;
+
+		if (rc != 0) {
+			fail(step, chain[i].name, rc);
+		}
+	}
+}
+
+static void expect_failure(const char *what, size_t i, const file_buf_t *cert,
+			   key_id_t signer, const file_buf_t *image)
+{
+	const char *step;
+
+	if (verify_cert(&chain[i], cert, signer, image, &step) == 0) {
+		fail(what, chain[i].name, 0);
+	}
+
+	if (auth_chain_test_verbose != 0) {
+		printf("%s, %s: rejected at %s\n", chain[i].name, what, step);
+	}
+}
+
+static void test_chain(unsigned int iterations)
+{
+	file_buf_t bad;
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		verify_chain();
+	}
+
+	printf("%u chain verifications, %u cached keys: OK\n", iterations,
+	       TF_MBEDTLS_PK_CACHE_ENTRIES);
+
+	/* A trusted world key certificate checked with the other world key */
+	expect_failure("wrong key", 2U, &certs[2], KEY_NON_TRUSTED_WORLD,
+		       &images[2]);
+
+	/* The signature is the last field of the certificate */
+	copy_file(&certs[1], &bad);
+	bad.data[bad.len - 8U] ^= 0x40U;
+	expect_failure("corrupted signature", 1U, &bad, chain[1].signer,
+		       &images[1]);
+	free(bad.data);
+
+	copy_file(&images[3], &bad);
+	bad.data[bad.len / 2U] ^= 0x01U;
+	expect_failure("corrupted image", 3U, &certs[3], chain[3].signer,
+		       &bad);
+	free(bad.data);
+
+	/* The chain must still verify after the failures */
+	verify_chain();
+
+	printf("wrong key, corrupted signature and image rejected: OK\n");
+}
+
+static void bench(unsigned int iterations)
+{
+	uint64_t total = 0U;
+
+	/* The first verification parses the keys in any case */
+	verify_chain();
+	memset(cert_ns, 0, sizeof(cert_ns));
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		verify_chain();
+	}
+
+	printf("%u cached keys, heap of %u bytes:\n",
+	       TF_MBEDTLS_PK_CACHE_ENTRIES, (unsigned int)TF_MBEDTLS_HEAP_SIZE);
+	for (size_t i = 0U; i < ARRAY_SIZE(chain); i++) {
+		printf("  %-20s %8" PRIu64 " us\n", chain[i].name,
+		       cert_ns[i] / iterations / 1000U);
+		total += cert_ns[i];
+	}
+	printf("  %-20s %8" PRIu64 " us\n", "chain", total / iterations / 1000U);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-v] [-b] [-n iterations] [-d directory]\n",
+		prog);
+	quit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int iterations = 10U;
+	bool benchmark = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:d:")) != -1) {
+		switch (opt) {
+		case 'v':
+			auth_chain_test_verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			cert_dir = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U)) {
+		usage(argv[0]);
+	}
+
+	load_file("rotpk.der", &keys[KEY_ROT]);
+	for (size_t i = 0U; i < ARRAY_SIZE(chain); i++) {
+		load_file(chain[i].name, &certs[i]);
+		if (chain[i].image != NULL) {
+			load_file(chain[i].image, &images[i]);
+		}
+	}
+
+	parser = x509_parser_lib_desc();
+	crypto_mod_init();
+	parser->init();
+
+	if (benchmark) {
+		bench(iterations);
+	} else {
+		test_chain(iterations);
+	}
+
+	quit(0);
+}
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+/* Host replacement, the host caches are coherent */
+
+#include <stddef.h>
+#include <stdint.h>
+
+static inline void clean_dcache_range(uintptr_t addr, size_t size)
+{
+	(void)addr;
+	(void)size;
+}
+
+#endif /* ARCH_HELPERS_H */
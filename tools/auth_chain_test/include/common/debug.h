@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+/* Host replacement for the firmware logging macros */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lib/utils_def.h>
+
+extern int auth_chain_test_verbose;
+
+#define ERROR(...)							\
+	do {								\
+		if (auth_chain_test_verbose != 0) {			\
+			fprintf(stderr, __VA_ARGS__);			\
+		}							\
+	} while (0)
+#define WARN(...)	ERROR(__VA_ARGS__)
+#define NOTICE(...)	do { } while (0)
+#define INFO(...)	do { } while (0)
+#define VERBOSE(...)	do { } while (0)
+
+#define panic()		abort()
+
+#endif /* DEBUG_H */
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/* Host replacement, the mbed TLS modules only need the heap */
+
+#include <stddef.h>
+
+int plat_get_mbedtls_heap(void **heap_addr, size_t *heap_size);
+int get_mbedtls_heap_helper(void **heap_addr, size_t *heap_size);
+
+#endif /* PLATFORM_H */
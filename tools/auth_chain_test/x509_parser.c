@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * The X.509 parser registers itself in a linker section that the host does not
+ * collect, so build it here and export its descriptor instead.
+ */
+
+#include "../../drivers/auth/mbedtls/mbedtls_x509_parser.c"
+
+const img_parser_lib_desc_t *x509_parser_lib_desc(void)
+{
+	return &__img_parser_lib_desc_IMG_CERT;
+}
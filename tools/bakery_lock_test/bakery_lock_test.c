@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host contention test of the PSCI power domain locks, i.e. the bakery locks
+ * of lib/locks/bakery/bakery_lock_normal.c. Each simulated CPU is a thread
+ * which repeatedly takes the locks that CPU_SUSPEND, CPU_ON and CPU_OFF take:
+ * the lock of its cluster, then for a quarter of the iterations the lock of
+ * the system, in the order of psci_acquire_pwr_domain_locks(). The locks are
+ * either taken by scanning the tickets of all the CPUs, as bakery_lock_get()
+ * does, or of the CPUs of the power domain only, as psci_lock_get() does.
+ * The test checks the mutual exclusion of each power domain. The benchmark
+ * reports the lock wait and hold times, and the number of cache maintenance
+ * operations per acquisition.
+ */
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <arch_helpers.h>
+#include <cdefs.h>
+#include <lib/bakery_lock.h>
+#include <plat/common/platform.h>
+
+#define ARRAY_SIZE(a)		(sizeof(a) / sizeof((a)[0]))
+
+/* One lock per cluster and one for the system */
+#define MAX_LOCKS		(PLAT_PERCPU_BAKERY_LOCK_SIZE /		\
+				 sizeof(bakery_info_t))
+#define NO_OWNER		(-1)
+
+typedef struct lock_mode {
+	const char *name;
+	bool range;
+} lock_mode_t;
+
+typedef struct cpu_stats {
+	unsigned long acquisitions;
+	unsigned long system_iterations;
+	unsigned long cache_ops;
+	uint64_t wait_ns;
+	uint64_t max_wait_ns;
+	uint64_t hold_ns;
+} cpu_stats_t;
+
+static const lock_mode_t modes[] = {
+	{ "all CPUs", false },
+	{ "power domain", true },
+};
+
+__thread unsigned long host_cache_ops;
+bool host_oversubscribed;
+bool host_dcache_enabled = true;
+
+static __thread unsigned int my_core_pos;
+
+static int verbose;
+static bool benchmark;
+static unsigned int cpu_count = 16U;
+static unsigned int cluster_cpus = 4U;
+static unsigned int cluster_count;
+static unsigned int iterations = 1000U;
+static unsigned int seed = 1U;
+
+static const lock_mode_t *mode;
+static uint8_t *lock_mem;
+static pthread_barrier_t start_barrier;
+
+/* Owner and number of critical sections of each power domain */
+static volatile int domain_owner[MAX_LOCKS];
+static unsigned long domain_count[MAX_LOCKS];
+
+static cpu_stats_t stats[PLATFORM_CORE_COUNT];
+
+unsigned int plat_my_core_pos(void)
+{
+	return my_core_pos;
+}
+
+static void __dead2 fail(const char *what, unsigned int cpu,
+			 unsigned int domain)
+{
+	fprintf(stderr, "FAILED: %s: %s, CPU %u, power domain %u\n",
+		mode->name, what, cpu, domain);
+	exit(1);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * The locks are laid out as by the linker script: the bakery information of
+ * all the locks for a CPU, then those for the next CPU.
+ */
+static bakery_lock_t *domain_lock(unsigned int domain)
+{
+	return (bakery_lock_t *)&lock_mem[domain * sizeof(bakery_info_t)];
+}
+
+static unsigned int system_domain(void)
+{
+	return cluster_count;
+}
+
+static void domain_cpus(unsigned int domain, unsigned int *first,
+			unsigned int *count)
+{
+	if (domain == system_domain()) {
+		*first = 0U;
+		*count = cpu_count;
+	} else {
+		*first = domain * cluster_cpus;
+		*count = MIN(cluster_cpus, cpu_count - *first);
+	}
+}
+
+static void domain_lock_get(unsigned int domain)
+{
+	unsigned int first, count;
+
+	if (mode->range) {
+		domain_cpus(domain, &first, &count);
+		bakery_lock_get_range(domain_lock(domain), first, count);
+	} else {
+		bakery_lock_get(domain_lock(domain));
+	}
+}
+
+static void domain_enter(unsigned int domain)
+{
+	if (domain_owner[domain] != NO_OWNER) {
+		fail("power domain lock held twice", my_core_pos, domain);
+	}
+	domain_owner[domain] = (int)my_core_pos;
+	domain_count[domain]++;
+}
+
+static void domain_exit(unsigned int domain)
+{
+	if (domain_owner[domain] != (int)my_core_pos) {
+		fail("power domain lock held twice", my_core_pos, domain);
+	}
+	domain_owner[domain] = NO_OWNER;
+}
+
+/* Stand in for the power state coordination done under the locks */
+static void delay(unsigned int *rand_state, unsigned int max)
+{
+	unsigned int n = (unsigned int)rand_r(rand_state) % max;
+
+	for (volatile unsigned int i = 0U; i < n; i++) {
+	}
+}
+
+static void *cpu_main(void *arg)
+{
+	cpu_stats_t *st = arg;
+	unsigned int cluster, rand_state;
+	uint64_t t0, t1, wait;
+	bool system;
+
+	my_core_pos = (unsigned int)(st - stats);
+	cluster = my_core_pos / cluster_cpus;
+	rand_state = seed + my_core_pos;
+	host_cache_ops = 0U;
+
+	(void)pthread_barrier_wait(&start_barrier);
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		system = ((unsigned int)rand_r(&rand_state) % 4U) == 0U;
+
+		t0 = now_ns();
+		domain_lock_get(cluster);
+		if (system) {
+			domain_lock_get(system_domain());
+		}
+		t1 = now_ns();
+
+		domain_enter(cluster);
+		if (system) {
+			domain_enter(system_domain());
+			st->system_iterations++;
+		}
+
+		/* Let the other CPUs run, to catch a lock that they also hold */
+		if (host_oversubscribed) {
+			(void)sched_yield();
+		}
+		delay(&rand_state, 200U);
+
+		if (system) {
+			domain_exit(system_domain());
+		}
+		domain_exit(cluster);
+
+		st->hold_ns += now_ns() - t1;
+		if (system) {
+			bakery_lock_release(domain_lock(system_domain()));
+		}
+		bakery_lock_release(domain_lock(cluster));
+
+		wait = t1 - t0;
+		st->wait_ns += wait;
+		st->max_wait_ns = MAX(st->max_wait_ns, wait);
+		st->acquisitions += system ? 2U : 1U;
+
+		delay(&rand_state, 1000U);
+	}
+
+	st->cache_ops = host_cache_ops;
+
+	return NULL;
+}
+
+static void run(const lock_mode_t *m)
+{
+	pthread_t threads[PLATFORM_CORE_COUNT];
+	unsigned long acquisitions = 0U, system_iterations = 0U;
+	unsigned long cache_ops = 0U;
+	uint64_t wait_ns = 0U, max_wait_ns = 0U, hold_ns = 0U;
+	unsigned int first, count;
+
+	mode = m;
+	memset(lock_mem, 0, PLATFORM_CORE_COUNT * PLAT_PERCPU_BAKERY_LOCK_SIZE);
+	memset(stats, 0, sizeof(stats));
+	memset(domain_count, 0, sizeof(domain_count));
+	for (unsigned int d = 0U; d < MAX_LOCKS; d++) {
+		domain_owner[d] = NO_OWNER;
+	}
+
+	if (pthread_barrier_init(&start_barrier, NULL, cpu_count) != 0) {
+		perror("pthread_barrier_init");
+		exit(2);
+	}
+	for (unsigned int cpu = 0U; cpu < cpu_count; cpu++) {
+		if (pthread_create(&threads[cpu], NULL, cpu_main,
+				   &stats[cpu]) != 0) {
+			perror("pthread_create");
+			exit(2);
+		}
+	}
+	for (unsigned int cpu = 0U; cpu < cpu_count; cpu++) {
+		(void)pthread_join(threads[cpu], NULL);
+	}
+	(void)pthread_barrier_destroy(&start_barrier);
+
+	for (unsigned int cpu = 0U; cpu < cpu_count; cpu++) {
+		acquisitions += stats[cpu].acquisitions;
+		system_iterations += stats[cpu].system_iterations;
+		cache_ops += stats[cpu].cache_ops;
+		wait_ns += stats[cpu].wait_ns;
+		hold_ns += stats[cpu].hold_ns;
+		max_wait_ns = MAX(max_wait_ns, stats[cpu].max_wait_ns);
+	}
+
+	/* Each critical section must have been counted exactly once */
+	for (unsigned int d = 0U; d < cluster_count; d++) {
+		domain_cpus(d, &first, &count);
+		if (domain_count[d] != ((unsigned long)count * iterations)) {
+			fail("lost critical section", first, d);
+		}
+	}
+	if (domain_count[system_domain()] != system_iterations) {
+		fail("lost critical section", 0U, system_domain());
+	}
+
+	if (!benchmark) {
+		if (verbose != 0) {
+			printf("%s: %lu acquisitions, %lu cache maintenance "
+			       "operations\n", m->name, acquisitions, cache_ops);
+		}
+		printf("%s: %u CPUs, %u iterations: OK\n", m->name,
+		       cpu_count, iterations);
+		return;
+	}
+
+	printf("%-12s %3u CPUs, clusters of %u: wait %8" PRIu64
+	       " ns, max %9" PRIu64 " ns, hold %6" PRIu64 " ns, "
+	       "%5.1f cache maintenance operations per acquisition\n", m->name,
+	       cpu_count, cluster_cpus,
+	       wait_ns / ((uint64_t)cpu_count * iterations), max_wait_ns,
+	       hold_ns / ((uint64_t)cpu_count * iterations),
+	       (double)cache_ops / (double)acquisitions);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-v] [-b] [-n iterations] [-s seed] "
+		"[-c cpus] [-k cpus per cluster]\n", prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	long host_cpus;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:s:c:k:")) != -1) {
+		switch (opt) {
+		case 'v':
+			verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			cpu_count = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 'k':
+			cluster_cpus = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U) || (cpu_count == 0U) ||
+	    (cpu_count > PLATFORM_CORE_COUNT) || (cluster_cpus == 0U)) {
+		usage(argv[0]);
+	}
+
+	cluster_count = (cpu_count + cluster_cpus - 1U) / cluster_cpus;
+	if (cluster_count >= MAX_LOCKS) {
+		fprintf(stderr, "At most %zu clusters\n", MAX_LOCKS - 1U);
+		exit(2);
+	}
+
+	host_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	host_oversubscribed = (host_cpus > 0) && (cpu_count > host_cpus);
+	if (benchmark && host_oversubscribed) {
+		printf("%u CPUs simulated on %ld host CPUs, the times include "
+		       "the scheduling of the CPUs that are waited for\n",
+		       cpu_count, host_cpus);
+	}
+
+	lock_mem = aligned_alloc(CACHE_WRITEBACK_GRANULE,
+				 PLATFORM_CORE_COUNT *
+				 PLAT_PERCPU_BAKERY_LOCK_SIZE);
+	if (lock_mem == NULL) {
+		perror("aligned_alloc");
+		exit(2);
+	}
+
+	for (size_t i = 0U; i < ARRAY_SIZE(modes); i++) {
+		run(&modes[i]);
+	}
+
+	free(lock_mem);
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef ARCH_HELPERS_H
+#define ARCH_HELPERS_H
+
+/*
+ * Host replacement for the barriers, events and cache maintenance used by the
+ * bakery locks. The barriers are full fences. The cache maintenance
+ * operations are counted, as they dominate the cost of a lock acquisition
+ * while the firmware runs with the data cache enabled but before the CPU
+ * takes part in coherency.
+ */
+
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cdefs.h>
+
+/* Cache maintenance operations of the current simulated CPU */
+extern __thread unsigned long host_cache_ops;
+
+/*
+ * Set when there are more simulated CPUs than host CPUs. The spin loops of the
+ * locks then give up the host CPU, as the contender that they wait for may
+ * not be running.
+ */
+extern bool host_oversubscribed;
+
+extern bool host_dcache_enabled;
+
+static inline void dccvac(uintptr_t addr)
+{
+	(void)addr;
+	host_cache_ops++;
+}
+
+static inline void dcivac(uintptr_t addr)
+{
+	(void)addr;
+	host_cache_ops++;
+}
+
+static inline void dccivac(uintptr_t addr)
+{
+	(void)addr;
+	host_cache_ops++;
+}
+
+static inline void dsb(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void dsbish(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void dmbish(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	if (host_oversubscribed) {
+		(void)sched_yield();
+	}
+}
+
+static inline void sev(void)
+{
+}
+
+static inline void wfe(void)
+{
+	(void)sched_yield();
+}
+
+static inline bool is_dcache_enabled(void)
+{
+	return host_dcache_enabled;
+}
+
+#endif /* ARCH_HELPERS_H */
@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CPU_DATA_H
+#define CPU_DATA_H
+
+/* Host replacement, the bakery locks only need CASSERT() from it */
+
+#include <lib/cassert.h>
+
+#endif /* CPU_DATA_H */
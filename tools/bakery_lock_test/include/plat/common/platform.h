@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+/* Host replacement, each simulated CPU is a thread */
+
+unsigned int plat_my_core_pos(void);
+
+#endif /* PLATFORM_H */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/* Platform definitions needed by the bakery locks */
+
+/* Largest number of CPUs that the test can simulate */
+#define PLATFORM_CORE_COUNT		256
+#define CACHE_WRITEBACK_GRANULE		64
+
+/* Room for the bakery information of 128 locks per CPU */
+#define PLAT_PERCPU_BAKERY_LOCK_SIZE	256
+
+#endif /* PLATFORM_DEF_H */
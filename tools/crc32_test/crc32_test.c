@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of tf_crc32() in common/tf_crc32.c. It uses the CRC32
+ * instructions on AArch64 hosts, and a bitwise replacement of their
+ * intrinsics elsewhere, so that the head, double word and tail processing of
+ * the buffers is checked on any host. The results must match known CRC-32
+ * check values, and a table based reference for all the small sizes and
+ * alignments, for random buffers and when computed piecewise. The benchmark
+ * compares tf_crc32() with a byte at a time loop over the same intrinsic.
+ */
+
+#include <arm_acle.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cdefs.h>
+#include <common/tf_crc32.h>
+
+#define ARRAY_SIZE(a)		(sizeof(a) / sizeof((a)[0]))
+
+/* All the sizes up to this one are checked with all the alignments */
+#define MAX_SMALL		100U
+#define MAX_RANDOM		(64U * 1024U)
+
+typedef struct vector {
+	const char *data;
+	size_t len;
+	uint32_t crc;
+} vector_t;
+
+/* CRC-32 (ISO-HDLC) check values */
+static const vector_t vectors[] = {
+	{ "", 0U, 0x00000000U },
+	{ "a", 1U, 0xE8B7BE43U },
+	{ "abc", 3U, 0x352441C2U },
+	{ "123456789", 9U, 0xCBF43926U },
+	{ "message digest", 14U, 0x20159D7FU },
+	{ "abcdefghijklmnopqrstuvwxyz", 26U, 0x4C2750BDU },
+	{ "The quick brown fox jumps over the lazy dog", 43U, 0x414FA339U },
+	{ "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
+	  32U, 0x190A55ADU },
+	{ "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff"
+	  "\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff",
+	  32U, 0xFF6CAB0BU },
+};
+
+static int verbose;
+
+static uint32_t ref_table[256];
+
+static uint8_t *buf;
+
+static void __dead2 fail(const char *what, size_t len, size_t offset)
+{
+	fprintf(stderr, "FAILED: %s, size %zu, offset %zu\n", what, len,
+		offset);
+	exit(1);
+}
+
+static void ref_init(void)
+{
+	uint32_t crc;
+
+	for (unsigned int i = 0U; i < 256U; i++) {
+		crc = i;
+		for (unsigned int bit = 0U; bit < 8U; bit++) {
+			crc = ((crc & 1U) != 0U) ? ((crc >> 1) ^ 0xEDB88320U) :
+						   (crc >> 1);
+		}
+		ref_table[i] = crc;
+	}
+}
+
+static uint32_t ref_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0U; i < len; i++) {
+		crc = (crc >> 8) ^ ref_table[(crc ^ data[i]) & 0xFFU];
+	}
+
+	return ~crc;
+}
+
+/* The implementation that tf_crc32() replaces, for the benchmark */
+static uint32_t bytewise_crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+	crc = ~crc;
+	for (size_t i = 0U; i < len; i++) {
+		crc = __crc32b(crc, data[i]);
+	}
+
+	return ~crc;
+}
+
+static void test_vectors(void)
+{
+	for (size_t i = 0U; i < ARRAY_SIZE(vectors); i++) {
+		/* Copy at each alignment, the head and tail loops differ */
+		for (size_t offset = 0U; offset < 8U; offset++) {
+			memcpy(&buf[offset], vectors[i].data, vectors[i].len);
+			if (tf_crc32(0U, &buf[offset], vectors[i].len) !=
+			    vectors[i].crc) {
+				fail("check value", vectors[i].len, offset);
+			}
+		}
+	}
+
+	printf("%zu check values, all alignments: OK\n", ARRAY_SIZE(vectors));
+}
+
+static void check(size_t len, size_t offset, uint32_t seed)
+{
+	const uint8_t *data = &buf[offset];
+	uint32_t expected = ref_crc32(seed, data, len);
+	size_t split;
+
+	if (tf_crc32(seed, data, len) != expected) {
+		fail("tf_crc32", len, offset);
+	}
+
+	/* The CRC of the whole is the CRC of the second part seeded by the first */
+	split = (len == 0U) ? 0U : ((size_t)rand() % len);
+	if (tf_crc32(tf_crc32(seed, data, split), &data[split],
+		     len - split) != expected) {
+		fail("piecewise tf_crc32", len, offset);
+	}
+}
+
+static void test_small(void)
+{
+	for (size_t len = 0U; len <= MAX_SMALL; len++) {
+		for (size_t offset = 0U; offset < 8U; offset++) {
+			check(len, offset, 0U);
+			check(len, offset, (uint32_t)rand());
+		}
+	}
+
+	printf("sizes up to %u, all alignments: OK\n", MAX_SMALL);
+}
+
+static void test_random(unsigned int iterations)
+{
+	size_t len, offset;
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		len = (size_t)rand() % (MAX_RANDOM + 1U);
+		offset = (size_t)rand() % 8U;
+
+		if (verbose != 0) {
+			printf("size %zu, offset %zu\n", len, offset);
+		}
+
+		check(len, offset, (uint32_t)rand());
+	}
+
+	printf("%u random sizes up to %u: OK\n", iterations, MAX_RANDOM);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Throughput in MB/s of a CRC function over the same number of bytes */
+static uint64_t bench_one(uint32_t (*fn)(uint32_t, const uint8_t *, size_t),
+			  size_t len, size_t offset, unsigned int iterations)
+{
+	volatile uint32_t sink = 0U;
+	uint64_t t0 = now_ns();
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		sink = fn(sink, &buf[offset], len);
+	}
+
+	return ((uint64_t)iterations * len * 1000U) / (now_ns() - t0 + 1U);
+}
+
+static uint32_t tf_crc32_fn(uint32_t crc, const uint8_t *data, size_t len)
+{
+	return tf_crc32(crc, data, len);
+}
+
+static void bench(size_t len, size_t offset, unsigned int iterations)
+{
+	/* Process the same number of bytes whatever the size */
+	iterations = (unsigned int)(((unsigned long)iterations * MAX_RANDOM) /
+				    len);
+
+	printf("%6zu bytes, offset %zu: tf_crc32 %6" PRIu64
+	       " MB/s, byte at a time %6" PRIu64 " MB/s\n", len, offset,
+	       bench_one(tf_crc32_fn, len, offset, iterations),
+	       bench_one(bytewise_crc32, len, offset, iterations));
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-v] [-b] [-n iterations] [-s seed]\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	/* GPT header and entry, a page and a large image */
+	static const size_t bench_sizes[] = { 92U, 128U, 4096U, 65536U };
+	unsigned int iterations = 1000U;
+	unsigned int seed = 1U;
+	bool benchmark = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:s:")) != -1) {
+		switch (opt) {
+		case 'v':
+			verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U)) {
+		usage(argv[0]);
+	}
+
+	srand(seed);
+	ref_init();
+
+	buf = aligned_alloc(64U, MAX_RANDOM + 64U);
+	if (buf == NULL) {
+		perror("aligned_alloc");
+		exit(2);
+	}
+	for (size_t i = 0U; i < (MAX_RANDOM + 64U); i++) {
+		buf[i] = (uint8_t)rand();
+	}
+
+	if (benchmark) {
+		for (size_t i = 0U; i < ARRAY_SIZE(bench_sizes); i++) {
+			bench(bench_sizes[i], 0U, iterations);
+			bench(bench_sizes[i], 3U, iterations);
+		}
+	} else {
+		test_vectors();
+		test_small();
+		test_random(iterations);
+	}
+
+	free(buf);
+
+	return 0;
+}
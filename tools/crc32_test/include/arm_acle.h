@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef CRC32_TEST_ARM_ACLE_H
+#define CRC32_TEST_ARM_ACLE_H
+
+/*
+ * Use the CRC32 instructions when the host has them, or else replace their
+ * intrinsics with a bitwise computation of the same CRC-32.
+ */
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include_next <arm_acle.h>
+#else
+#include <stdint.h>
+
+static inline uint32_t __crc32b(uint32_t crc, uint8_t data)
+{
+	crc ^= data;
+	for (unsigned int i = 0U; i < 8U; i++) {
+		crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+	}
+
+	return crc;
+}
+
+static inline uint32_t __crc32d(uint32_t crc, uint64_t data)
+{
+	/* Least significant byte first, as the instruction does */
+	for (unsigned int i = 0U; i < 8U; i++) {
+		crc = __crc32b(crc, (uint8_t)(data >> (8U * i)));
+	}
+
+	return crc;
+}
+#endif
+
+#endif /* CRC32_TEST_ARM_ACLE_H */
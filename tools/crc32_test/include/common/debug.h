@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef DEBUG_H
+#define DEBUG_H
+
+/* Host replacement for the firmware logging macros, which tf_crc32 does not use */
+
+#endif /* DEBUG_H */
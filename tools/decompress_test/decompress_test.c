@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the decompressors used by image_decompress(): lib/zlib
+ * (gunzip() and gunzip_stream_*()) and lib/lz4 (lz4_decompress() and
+ * lz4_stream_*()). With IMAGE_DECOMPRESS_STREAMING, they parse compressed data
+ * before it is authenticated, so besides checking the output against the
+ * original data, this feeds them truncated, corrupted and random input. It is
+ * meant to be built with the address and undefined behaviour sanitizers, which
+ * report any access outside the buffers, and can also be built as a libFuzzer
+ * target.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <tf_gunzip.h>
+#include <tf_lz4.h>
+
+/* Enough for the inflate state and its 32 KB window */
+#define WORK_SIZE	(64U * 1024U)
+
+typedef int (*decompress_fn)(uintptr_t *in_buf, size_t in_len,
+			     uintptr_t *out_buf, size_t out_len,
+			     uintptr_t work_buf, size_t work_len);
+
+typedef struct decompressor {
+	const char *name;
+	decompress_fn decompress;
+	int (*start)(uintptr_t out_buf, size_t out_len, uintptr_t work_buf,
+		     size_t work_len);
+	int (*update)(uintptr_t in_buf, size_t in_len);
+	int (*finish)(uintptr_t *out_buf);
+} decompressor_t;
+
+static const decompressor_t decompressors[] = {
+	{ "gzip", gunzip, gunzip_stream_start, gunzip_stream_update,
+	  gunzip_stream_finish },
+	{ "lz4", lz4_decompress, lz4_stream_start, lz4_stream_update,
+	  lz4_stream_finish },
+};
+
+int decompress_test_verbose;
+
+static unsigned char work[WORK_SIZE];
+static unsigned int failures;
+
+/* Chunk size modes of run_stream() */
+#define CHUNK_RANDOM	0U
+
+static size_t next_chunk(size_t chunk, size_t left)
+{
+	size_t len = chunk;
+
+	if (chunk == CHUNK_RANDOM) {
+		len = 1U + ((size_t)rand() % 5000U);
+	}
+
+	return (len < left) ? len : left;
+}
+
+/*
+ * Decompress 'in' to a buffer of exactly out_len bytes, allocated on its own
+ * so that the sanitizer catches any write past it. Returns the decompressor
+ * result and the output in *out and *out_size on success.
+ */
+static int run_oneshot(const decompressor_t *d, const unsigned char *in,
+		       size_t in_len, size_t out_len, unsigned char **out,
+		       size_t *out_size)
+{
+	unsigned char *in_copy = malloc(in_len + 1U);
+	unsigned char *buf = malloc(out_len + 1U);
+	uintptr_t in_buf = (uintptr_t)in_copy;
+	uintptr_t out_buf = (uintptr_t)buf;
+	int ret;
+
+	if ((in_copy == NULL) || (buf == NULL)) {
+		perror("malloc");
+		exit(2);
+	}
+
+	memcpy(in_copy, in, in_len);
+	ret = d->decompress(&in_buf, in_len, &out_buf, out_len,
+			    (uintptr_t)work, sizeof(work));
+	free(in_copy);
+
+	if ((ret == 0) && (out_buf - (uintptr_t)buf > out_len)) {
+		fprintf(stderr, "%s: output past the end of the buffer\n",
+			d->name);
+		failures++;
+	}
+
+	*out = buf;
+	*out_size = out_buf - (uintptr_t)buf;
+
+	return ret;
+}
+
+/*
+ * Same as run_oneshot() with the streaming functions, passing the input in
+ * chunks of 'chunk' bytes, each in its own allocation.
+ */
+static int run_stream(const decompressor_t *d, const unsigned char *in,
+		      size_t in_len, size_t out_len, size_t chunk,
+		      unsigned char **out, size_t *out_size)
+{
+	unsigned char *buf = malloc(out_len + 1U);
+	uintptr_t out_end = (uintptr_t)buf;
+	size_t off = 0U, len;
+	unsigned char *piece;
+	int ret;
+
+	if (buf == NULL) {
+		perror("malloc");
+		exit(2);
+	}
+
+	*out = buf;
+	*out_size = 0U;
+
+	ret = d->start((uintptr_t)buf, out_len, (uintptr_t)work, sizeof(work));
+	if (ret != 0) {
+		return ret;
+	}
+
+	while (off < in_len) {
+		len = next_chunk(chunk, in_len - off);
+		piece = malloc(len);
+		if (piece == NULL) {
+			perror("malloc");
+			exit(2);
+		}
+
+		memcpy(piece, &in[off], len);
+		ret = d->update((uintptr_t)piece, len);
+		free(piece);
+		if (ret != 0) {
+			return ret;
+		}
+
+		off += len;
+	}
+
+	ret = d->finish(&out_end);
+	if ((ret == 0) && (out_end - (uintptr_t)buf > out_len)) {
+		fprintf(stderr, "%s: output past the end of the buffer\n",
+			d->name);
+		failures++;
+	}
+
+	*out_size = out_end - (uintptr_t)buf;
+
+	return ret;
+}
+
+static void check(bool cond, const decompressor_t *d, const char *what)
+{
+	if (!cond) {
+		fprintf(stderr, "%s: FAILED: %s\n", d->name, what);
+		failures++;
+	}
+}
+
+static bool same(const unsigned char *out, size_t out_size,
+		 const unsigned char *raw, size_t raw_len)
+{
+	return (out_size == raw_len) && (memcmp(out, raw, raw_len) == 0);
+}
+
+/* Decompress valid input in all the supported ways */
+static void test_valid(const decompressor_t *d, const unsigned char *in,
+		       size_t in_len, const unsigned char *raw, size_t raw_len)
+{
+	static const size_t chunks[] = { 1U, 2U, 3U, 7U, 64U, 4096U, 16384U,
+					 CHUNK_RANDOM };
+	unsigned char *out;
+	size_t out_size, i;
+	int ret;
+
+	ret = run_oneshot(d, in, in_len, raw_len, &out, &out_size);
+	check((ret == 0) && same(out, out_size, raw, raw_len), d,
+	      "one-shot decompression");
+	free(out);
+
+	for (i = 0U; i < (sizeof(chunks) / sizeof(chunks[0])); i++) {
+		ret = run_stream(d, in, in_len, raw_len, chunks[i], &out,
+				 &out_size);
+		check((ret == 0) && same(out, out_size, raw, raw_len), d,
+		      "streaming decompression");
+		free(out);
+	}
+
+	/* Output buffer one byte too small */
+	if (raw_len != 0U) {
+		ret = run_oneshot(d, in, in_len, raw_len - 1U, &out, &out_size);
+		check(ret != 0, d, "one-shot overflow detection");
+		free(out);
+
+		ret = run_stream(d, in, in_len, raw_len - 1U, CHUNK_RANDOM,
+				 &out, &out_size);
+		check(ret != 0, d, "streaming overflow detection");
+		free(out);
+	}
+}
+
+/* Every input cut short must be rejected */
+static void test_truncated(const decompressor_t *d, const unsigned char *in,
+			   size_t in_len, size_t raw_len)
+{
+	unsigned char *out;
+	size_t out_size, len, step;
+	int ret;
+
+	step = (in_len / 512U) + 1U;
+	for (len = 0U; len < in_len; len += step) {
+		ret = run_stream(d, in, len, raw_len, CHUNK_RANDOM, &out,
+				 &out_size);
+		check(ret != 0, d, "truncated input detection");
+		free(out);
+	}
+}
+
+/*
+ * Corrupted input may or may not be rejected, depending on the checks the
+ * format allows, but it must never lead to an access out of the buffers.
+ */
+static void test_corrupted(const decompressor_t *d, const unsigned char *in,
+			   size_t in_len, size_t raw_len, unsigned int iterations)
+{
+	unsigned char *bad = malloc(in_len);
+	unsigned char *out;
+	size_t out_size;
+	unsigned int i, n, flips;
+
+	if (bad == NULL) {
+		perror("malloc");
+		exit(2);
+	}
+
+	for (i = 0U; i < iterations; i++) {
+		memcpy(bad, in, in_len);
+		flips = 1U + ((unsigned int)rand() % 8U);
+		for (n = 0U; n < flips; n++) {
+			bad[(size_t)rand() % in_len] ^=
+				(unsigned char)(1U + ((unsigned int)rand() % 255U));
+		}
+
+		(void)run_oneshot(d, bad, in_len, raw_len, &out, &out_size);
+		free(out);
+		(void)run_stream(d, bad, in_len, raw_len, CHUNK_RANDOM, &out,
+				 &out_size);
+		free(out);
+	}
+
+	free(bad);
+}
+
+#ifdef DECOMPRESS_TEST_LIBFUZZER
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+	unsigned char *out;
+	size_t out_size, i;
+
+	/* The first byte picks the output buffer size */
+	if (size == 0U) {
+		return 0;
+	}
+
+	for (i = 0U; i < (sizeof(decompressors) / sizeof(decompressors[0]));
+	     i++) {
+		(void)run_oneshot(&decompressors[i], &data[1], size - 1U,
+				  (size_t)data[0] * 256U, &out, &out_size);
+		free(out);
+		(void)run_stream(&decompressors[i], &data[1], size - 1U,
+				 (size_t)data[0] * 256U, 61U, &out, &out_size);
+		free(out);
+	}
+
+	return 0;
+}
+#else
+static unsigned char *read_file(const char *name, size_t *len)
+{
+	unsigned char *buf = NULL;
+	long size;
+	FILE *f;
+
+	f = fopen(name, "rb");
+	if (f == NULL) {
+		perror(name);
+		exit(2);
+	}
+
+	if ((fseek(f, 0L, SEEK_END) != 0) || ((size = ftell(f)) < 0L) ||
+	    (fseek(f, 0L, SEEK_SET) != 0)) {
+		perror(name);
+		exit(2);
+	}
+
+	/* Allocate at least one byte so that empty files work too */
+	buf = malloc((size_t)size + 1U);
+	if ((buf == NULL) ||
+	    (fread(buf, 1U, (size_t)size, f) != (size_t)size)) {
+		perror(name);
+		exit(2);
+	}
+
+	(void)fclose(f);
+	*len = (size_t)size;
+
+	return buf;
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [-v] [-n iterations] [-s seed] <gzip|lz4> <compressed file> <original file>\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	const decompressor_t *d = NULL;
+	unsigned int iterations = 1000U;
+	unsigned int seed = 1U;
+	unsigned char *in, *raw;
+	size_t in_len, raw_len, i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vn:s:")) != -1) {
+		switch (opt) {
+		case 'v':
+			decompress_test_verbose = 1;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((argc - optind) != 3) {
+		usage(argv[0]);
+	}
+
+	for (i = 0U; i < (sizeof(decompressors) / sizeof(decompressors[0]));
+	     i++) {
+		if (strcmp(argv[optind], decompressors[i].name) == 0) {
+			d = &decompressors[i];
+		}
+	}
+
+	if (d == NULL) {
+		usage(argv[0]);
+	}
+
+	srand(seed);
+
+	in = read_file(argv[optind + 1], &in_len);
+	raw = read_file(argv[optind + 2], &raw_len);
+
+	test_valid(d, in, in_len, raw, raw_len);
+	test_truncated(d, in, in_len, raw_len);
+	if (in_len != 0U) {
+		test_corrupted(d, in, in_len, raw_len, iterations);
+	}
+
+	free(in);
+	free(raw);
+
+	printf("%s %s: %s\n", d->name, argv[optind + 1],
+	       (failures == 0U) ? "OK" : "FAILED");
+
+	return (failures == 0U) ? 0 : 1;
+}
+#endif /* DECOMPRESS_TEST_LIBFUZZER */
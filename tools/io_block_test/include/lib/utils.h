@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef UTILS_H
+#define UTILS_H
+
+/* Host replacement for the firmware memory helpers */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <lib/utils_def.h>
+
+static inline void zeromem(void *mem, size_t length)
+{
+	memset(mem, 0, length);
+}
+
+#endif /* UTILS_H */
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/* Platform definitions needed by the IO layer and the block driver */
+
+#define MAX_IO_DEVICES			2
+#define MAX_IO_HANDLES			4
+#define MAX_IO_BLOCK_DEVICES		2U
+
+#endif /* PLATFORM_DEF_H */
@@ -0,0 +1,485 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the read cache of the IO block driver. io_storage.c and
+ * io_block.c are built into the test on top of a block device held in memory,
+ * which counts the commands it receives. A trace of the accesses made by a
+ * boot (GPT header and entries, FIP table of contents and images), or one read
+ * from a file, is replayed with and without the cache: the data read must
+ * match the device and the cache must need fewer device commands. Random reads
+ * and writes are then made through two openings of the same device, so that
+ * data cached through one of them and written through the other is caught.
+ */
+
+#include <assert.h>
+#include <cdefs.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <common/debug.h>
+#include <drivers/io/io_block.h>
+#include <drivers/io/io_driver.h>
+#include <drivers/io/io_storage.h>
+
+int io_block_test_verbose;
+
+#define BLOCK_SIZE		512U
+#define DEV_SIZE		(8U * 1024U * 1024U)
+#define BOUNCE_SIZE		(64U * 1024U)
+#define LINE_SIZE		(4U * 1024U)
+
+/* Layout of the device seen by the boot trace */
+#define GPT_ENTRIES_OFFSET	(2U * BLOCK_SIZE)
+#define GPT_ENTRY_COUNT		128U
+#define GPT_ENTRY_SIZE		128U
+#define FIP_OFFSET		(1U * 1024U * 1024U)
+#define FIP_IMAGE_COUNT		10U
+#define FIP_TOC_HEADER_SIZE	16U
+#define FIP_TOC_ENTRY_SIZE	40U
+
+/* Largest random access */
+#define MAX_ACCESS		(3U * BOUNCE_SIZE)
+
+typedef struct access {
+	bool write;
+	unsigned long long offset;
+	size_t length;
+} access_t;
+
+typedef struct trace {
+	access_t *accesses;
+	size_t count;
+	size_t max;
+} trace_t;
+
+static uint8_t *dev_mem;
+static unsigned long dev_cmds;
+static unsigned long long dev_bytes;
+
+static uint8_t *bounce;
+static uint8_t *cache_mem;
+static uint8_t *buf;
+
+static io_block_dev_spec_t dev_spec;
+static const io_dev_connector_t *block_dev_con;
+
+static const io_block_spec_t whole_dev = {
+	.offset = 0U,
+	.length = DEV_SIZE,
+};
+
+/*
+ * Stop at the first failure, as the data of the following accesses would be
+ * meaningless.
+ */
+static void __dead2 fail(const char *what)
+{
+	fprintf(stderr, "FAILED: %s\n", what);
+	exit(1);
+}
+
+/* The driver needs block aligned buffers */
+static void *xmalloc(size_t size)
+{
+	void *ptr = aligned_alloc(BLOCK_SIZE, size);
+
+	if (ptr == NULL) {
+		perror("aligned_alloc");
+		exit(2);
+	}
+
+	return ptr;
+}
+
+static size_t dev_read(int lba, uintptr_t dest, size_t size)
+{
+	unsigned long long offset = (unsigned long long)lba * BLOCK_SIZE;
+
+	if ((lba < 0) || (offset > DEV_SIZE) || (size > (DEV_SIZE - offset)) ||
+	    ((size % BLOCK_SIZE) != 0U)) {
+		fail("device read out of range or not block aligned");
+	}
+
+	memcpy((void *)dest, &dev_mem[offset], size);
+	dev_cmds++;
+	dev_bytes += size;
+
+	return size;
+}
+
+static size_t dev_write(int lba, const uintptr_t src, size_t size)
+{
+	unsigned long long offset = (unsigned long long)lba * BLOCK_SIZE;
+
+	if ((lba < 0) || (offset > DEV_SIZE) || (size > (DEV_SIZE - offset)) ||
+	    ((size % BLOCK_SIZE) != 0U)) {
+		fail("device write out of range or not block aligned");
+	}
+
+	memcpy(&dev_mem[offset], (const void *)src, size);
+	dev_cmds++;
+	dev_bytes += size;
+
+	return size;
+}
+
+static void trace_add(trace_t *t, bool write, unsigned long long offset,
+		      size_t length)
+{
+	if (t->count == t->max) {
+		t->max = (t->max == 0U) ? 256U : (t->max * 2U);
+		t->accesses = realloc(t->accesses,
+				      t->max * sizeof(*t->accesses));
+		if (t->accesses == NULL) {
+			perror("realloc");
+			exit(2);
+		}
+	}
+
+	t->accesses[t->count++] = (access_t){ write, offset, length };
+}
+
+/*
+ * Accesses of a boot which reads the GPT and then loads each image of the FIP:
+ * the FIP driver reads the table of contents header and then its entries one
+ * by one until it finds the image, for each image it opens.
+ */
+static void trace_boot(trace_t *t)
+{
+	unsigned long long image_offset = FIP_OFFSET + (4U * 1024U);
+	size_t image_size;
+
+	/* Protective MBR, GPT header and entries */
+	trace_add(t, false, 0U, BLOCK_SIZE);
+	trace_add(t, false, BLOCK_SIZE, 92U);
+	for (unsigned int i = 0U; i < GPT_ENTRY_COUNT; i++) {
+		trace_add(t, false, GPT_ENTRIES_OFFSET + (i * GPT_ENTRY_SIZE),
+			  GPT_ENTRY_SIZE);
+	}
+
+	for (unsigned int image = 0U; image < FIP_IMAGE_COUNT; image++) {
+		trace_add(t, false, FIP_OFFSET, FIP_TOC_HEADER_SIZE);
+		for (unsigned int i = 0U; i <= image; i++) {
+			trace_add(t, false, FIP_OFFSET + FIP_TOC_HEADER_SIZE +
+				  (i * FIP_TOC_ENTRY_SIZE), FIP_TOC_ENTRY_SIZE);
+		}
+
+		/* Certificates are small, images are large and unaligned */
+		image_size = ((image % 2U) == 0U) ? 1500U : 150000U + image;
+		trace_add(t, false, image_offset, image_size);
+		image_offset += image_size + 8U;
+	}
+}
+
+/*
+ * Read a trace from a file, one access per line: 'r' or 'w', then the offset
+ * and the length of the access in bytes.
+ */
+static void trace_load(trace_t *t, const char *path)
+{
+	unsigned long long offset;
+	size_t length;
+	char op;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL) {
+		perror(path);
+		exit(2);
+	}
+
+	while (fscanf(f, " %c %llu %zu", &op, &offset, &length) == 3) {
+		if (((op != 'r') && (op != 'w')) || (offset > DEV_SIZE) ||
+		    (length > (DEV_SIZE - offset)) || (length > MAX_ACCESS)) {
+			fprintf(stderr, "%s: invalid access %c %llu %zu\n",
+				path, op, offset, length);
+			exit(2);
+		}
+		trace_add(t, op == 'w', offset, length);
+	}
+
+	if (!feof(f)) {
+		fprintf(stderr, "%s: syntax error\n", path);
+		exit(2);
+	}
+
+	(void)fclose(f);
+}
+
+static void dev_fill(void)
+{
+	for (size_t i = 0U; i < DEV_SIZE; i++) {
+		dev_mem[i] = (uint8_t)rand();
+	}
+}
+
+static void open_dev(unsigned int line_count, uintptr_t *dev_handle,
+		     uintptr_t *handle)
+{
+	dev_spec.cache.line_count = line_count;
+
+	if ((io_dev_open(block_dev_con, (uintptr_t)&dev_spec,
+			 dev_handle) != 0) ||
+	    (io_open(*dev_handle, (uintptr_t)&whole_dev, handle) != 0)) {
+		fail("open");
+	}
+}
+
+static void close_dev(uintptr_t dev_handle, uintptr_t handle)
+{
+	if ((io_close(handle) != 0) || (io_dev_close(dev_handle) != 0)) {
+		fail("close");
+	}
+}
+
+static void do_access(uintptr_t handle, const access_t *a)
+{
+	size_t done = 0U;
+
+	if (io_seek(handle, IO_SEEK_SET, (signed long long)a->offset) != 0) {
+		fail("seek");
+	}
+
+	if (a->write) {
+		for (size_t i = 0U; i < a->length; i++) {
+			buf[i] = (uint8_t)rand();
+		}
+		if ((io_write(handle, (uintptr_t)buf, a->length, &done) != 0) ||
+		    (done != a->length)) {
+			fail("write");
+		}
+		if (memcmp(&dev_mem[a->offset], buf, a->length) != 0) {
+			fail("data written does not match the device");
+		}
+	} else {
+		if ((io_read(handle, (uintptr_t)buf, a->length, &done) != 0) ||
+		    (done != a->length)) {
+			fail("read");
+		}
+		if (memcmp(&dev_mem[a->offset], buf, a->length) != 0) {
+			fail("data read does not match the device");
+		}
+	}
+}
+
+/* Replay a trace and return the number of device commands it took */
+static unsigned long replay(const trace_t *t, unsigned int line_count)
+{
+	uintptr_t dev_handle, handle;
+	unsigned long cmds = dev_cmds;
+
+	open_dev(line_count, &dev_handle, &handle);
+	for (size_t i = 0U; i < t->count; i++) {
+		do_access(handle, &t->accesses[i]);
+	}
+	close_dev(dev_handle, handle);
+
+	return dev_cmds - cmds;
+}
+
+static void test_trace(const char *name, const trace_t *t)
+{
+	unsigned long uncached, cached;
+
+	uncached = replay(t, 0U);
+	cached = replay(t, IO_BLOCK_CACHE_MAX_LINES);
+
+	printf("%s trace, %zu accesses: %lu device commands without the cache, "
+	       "%lu with it", name, t->count, uncached, cached);
+	if (cached > uncached) {
+		printf("\n");
+		fail("the cache needs more device commands");
+	}
+	printf(": OK\n");
+}
+
+static access_t random_access(void)
+{
+	access_t a;
+
+	a.write = ((unsigned int)rand() % 8U) == 0U;
+
+	/* Mostly small accesses, close together so that they share lines */
+	if (((unsigned int)rand() % 8U) == 0U) {
+		a.length = 1U + ((size_t)rand() % MAX_ACCESS);
+		a.offset = (unsigned long long)rand() % (DEV_SIZE - a.length);
+	} else {
+		a.length = 1U + ((size_t)rand() % (LINE_SIZE / 2U));
+		a.offset = (unsigned long long)rand() %
+			   ((16U * LINE_SIZE) - a.length);
+	}
+
+	return a;
+}
+
+/*
+ * Random accesses through two openings of the same device: both must see the
+ * data written through the other.
+ */
+static void test_shared(unsigned int iterations)
+{
+	uintptr_t dev_handle[2], handle[2];
+	io_block_cache_stats_t stats;
+	access_t a;
+
+	open_dev(IO_BLOCK_CACHE_MAX_LINES, &dev_handle[0], &handle[0]);
+	open_dev(IO_BLOCK_CACHE_MAX_LINES, &dev_handle[1], &handle[1]);
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		a = random_access();
+		do_access(handle[(unsigned int)rand() % 2U], &a);
+	}
+
+	if (io_block_get_cache_stats(&dev_spec, &stats) != 0) {
+		fail("cache statistics");
+	}
+
+	close_dev(dev_handle[1], handle[1]);
+	close_dev(dev_handle[0], handle[0]);
+
+	printf("shared device, %u accesses, %u hits, %u misses: OK\n",
+	       iterations, stats.hits, stats.misses);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Measure the replay of a trace from a cold cache, along with the device
+ * commands and bytes it takes, which dominate on a real device.
+ */
+static void bench(const char *name, const trace_t *t, unsigned int line_count,
+		  unsigned int iterations)
+{
+	unsigned long cmds = dev_cmds;
+	unsigned long long bytes = dev_bytes;
+	uint64_t t0 = now_ns();
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		(void)replay(t, line_count);
+	}
+
+	printf("%s trace, %s cache: %6" PRIu64 " ns, %5lu device commands, "
+	       "%8llu device bytes\n", name,
+	       (line_count == 0U) ? "without" : "   with",
+	       (now_ns() - t0) / iterations, (dev_cmds - cmds) / iterations,
+	       (dev_bytes - bytes) / iterations);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [-v] [-b] [-n iterations] [-s seed] [-t trace]\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int iterations = 10000U;
+	unsigned int seed = 1U;
+	bool benchmark = false;
+	const char *trace_path = NULL;
+	trace_t boot = { 0 }, file = { 0 };
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:s:t:")) != -1) {
+		switch (opt) {
+		case 'v':
+			io_block_test_verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 't':
+			trace_path = optarg;
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U)) {
+		usage(argv[0]);
+	}
+
+	srand(seed);
+
+	dev_mem = xmalloc(DEV_SIZE);
+	bounce = xmalloc(BOUNCE_SIZE);
+	cache_mem = xmalloc(IO_BLOCK_CACHE_MAX_LINES * LINE_SIZE);
+	buf = xmalloc(MAX_ACCESS);
+	dev_fill();
+
+	dev_spec = (io_block_dev_spec_t){
+		.buffer = {
+			.offset = (uintptr_t)bounce,
+			.length = BOUNCE_SIZE,
+		},
+		.ops = {
+			.read = dev_read,
+			.write = dev_write,
+		},
+		.block_size = BLOCK_SIZE,
+		.cache = {
+			.base = (uintptr_t)cache_mem,
+			.line_size = LINE_SIZE,
+		},
+	};
+
+	if (register_io_dev_block(&block_dev_con) != 0) {
+		fail("register");
+	}
+
+	trace_boot(&boot);
+	if (trace_path != NULL) {
+		trace_load(&file, trace_path);
+	}
+
+	if (benchmark) {
+		bench("boot", &boot, 0U, iterations);
+		bench("boot", &boot, IO_BLOCK_CACHE_MAX_LINES, iterations);
+		if (trace_path != NULL) {
+			bench(trace_path, &file, 0U, iterations);
+			bench(trace_path, &file, IO_BLOCK_CACHE_MAX_LINES,
+			      iterations);
+		}
+	} else {
+		test_trace("boot", &boot);
+		if (trace_path != NULL) {
+			test_trace(trace_path, &file);
+		}
+		test_shared(iterations);
+	}
+
+	free(boot.accesses);
+	free(file.accesses);
+	free(buf);
+	free(cache_mem);
+	free(bounce);
+	free(dev_mem);
+
+	return 0;
+}
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * C implementations of the firmware C library, renamed so that they do not
+ * replace those of the host.
+ */
+
+#include <string.h>
+
+#define memcpy		tf_c_memcpy
+#define memmove		tf_c_memmove
+#define memcmp		tf_c_memcmp
+
+#include "memcpy.c"
+#include "memmove.c"
+#include "memcmp.c"
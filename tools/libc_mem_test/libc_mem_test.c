@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the memcpy, memmove and memcmp implementations of the firmware
+ * C library. The C implementations are always built, and the AArch64 assembly
+ * ones when the host is AArch64. Each implementation is checked against the
+ * host C library for all the combinations of small sizes and source and
+ * destination alignments, for overlapping moves in both directions, and for
+ * random larger accesses. Bytes around the destination must not be written.
+ * The benchmark compares the implementations with those of the host.
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cdefs.h>
+
+#define ARRAY_SIZE(a)		(sizeof(a) / sizeof((a)[0]))
+
+/* All the sizes up to this one are checked with all the alignments */
+#define MAX_SMALL		160U
+#define MAX_ALIGN		16U
+/* Largest random access */
+#define MAX_RANDOM		(64U * 1024U)
+/* Bytes checked on each side of the destination */
+#define GUARD			32U
+#define BUF_SIZE		(MAX_RANDOM + (2U * (MAX_ALIGN + GUARD)))
+
+typedef void *(*memcpy_fn)(void *dst, const void *src, size_t len);
+typedef int (*memcmp_fn)(const void *s1, const void *s2, size_t len);
+
+typedef struct impl {
+	const char *name;
+	memcpy_fn memcpy;
+	memcpy_fn memmove;
+	memcmp_fn memcmp;
+} impl_t;
+
+void *tf_c_memcpy(void *dst, const void *src, size_t len);
+void *tf_c_memmove(void *dst, const void *src, size_t len);
+int tf_c_memcmp(const void *s1, const void *s2, size_t len);
+
+#ifdef LIBC_MEM_TEST_AARCH64
+void *tf_asm_memcpy(void *dst, const void *src, size_t len);
+void *tf_asm_memmove(void *dst, const void *src, size_t len);
+int tf_asm_memcmp(const void *s1, const void *s2, size_t len);
+#endif
+
+static const impl_t impls[] = {
+	{ "C", tf_c_memcpy, tf_c_memmove, tf_c_memcmp },
+#ifdef LIBC_MEM_TEST_AARCH64
+	{ "AArch64", tf_asm_memcpy, tf_asm_memmove, tf_asm_memcmp },
+#endif
+};
+
+static const impl_t host_impl = { "host", memcpy, memmove, memcmp };
+
+static int verbose;
+
+static uint8_t *src_buf, *dst_buf, *ref_buf;
+
+static void __dead2 fail(const impl_t *impl, const char *what, size_t len,
+			 size_t src_off, size_t dst_off)
+{
+	fprintf(stderr, "FAILED: %s %s, size %zu, source offset %zu, "
+		"destination offset %zu\n", impl->name, what, len, src_off,
+		dst_off);
+	exit(1);
+}
+
+static void *xmalloc(size_t size)
+{
+	/* Page aligned, so that the offsets give the alignment */
+	void *ptr = aligned_alloc(4096U, (size + 4095U) & ~(size_t)4095U);
+
+	if (ptr == NULL) {
+		perror("aligned_alloc");
+		exit(2);
+	}
+
+	return ptr;
+}
+
+static void random_fill(uint8_t *buf, size_t len)
+{
+	for (size_t i = 0U; i < len; i++) {
+		buf[i] = (uint8_t)rand();
+	}
+}
+
+static void check_memcpy(const impl_t *impl, size_t len, size_t src_off,
+			 size_t dst_off)
+{
+	uint8_t *dst = &dst_buf[GUARD + dst_off];
+	const uint8_t *src = &src_buf[GUARD + src_off];
+	size_t end = GUARD + dst_off + len + GUARD;
+
+	random_fill(dst_buf, end);
+	memcpy(ref_buf, dst_buf, end);
+	memcpy(&ref_buf[GUARD + dst_off], src, len);
+
+	if (impl->memcpy(dst, src, len) != dst) {
+		fail(impl, "memcpy return value", len, src_off, dst_off);
+	}
+	if (memcmp(dst_buf, ref_buf, end) != 0) {
+		fail(impl, "memcpy", len, src_off, dst_off);
+	}
+}
+
+/*
+ * Move 'len' bytes by 'shift' bytes within a single buffer, forwards or
+ * backwards.
+ */
+static void check_memmove(const impl_t *impl, size_t len, size_t off,
+			  long shift)
+{
+	size_t end = GUARD + MAX_ALIGN + len + MAX_ALIGN + GUARD;
+	uint8_t *src = &dst_buf[GUARD + MAX_ALIGN + off];
+	uint8_t *dst = src + shift;
+
+	random_fill(dst_buf, end);
+	memcpy(ref_buf, dst_buf, end);
+	memmove(&ref_buf[(size_t)(dst - dst_buf)],
+		&ref_buf[(size_t)(src - dst_buf)], len);
+
+	if (impl->memmove(dst, src, len) != dst) {
+		fail(impl, "memmove return value", len, off,
+		     (size_t)((long)off + shift));
+	}
+	if (memcmp(dst_buf, ref_buf, end) != 0) {
+		fail(impl, "memmove", len, off, (size_t)((long)off + shift));
+	}
+}
+
+/* The sign of the result must be right, as must be its value */
+static int byte_diff(const uint8_t *s1, const uint8_t *s2, size_t len)
+{
+	for (size_t i = 0U; i < len; i++) {
+		if (s1[i] != s2[i]) {
+			return (int)s1[i] - (int)s2[i];
+		}
+	}
+
+	return 0;
+}
+
+static void check_memcmp_at(const impl_t *impl, size_t len, size_t off1,
+			    size_t off2, size_t pos)
+{
+	uint8_t *s1 = &src_buf[GUARD + off1];
+	uint8_t *s2 = &dst_buf[GUARD + off2];
+
+	memcpy(s2, s1, len);
+	if (pos < len) {
+		/* Make either buffer the larger one */
+		s2[pos] = (uint8_t)(s1[pos] + 1U + ((unsigned int)rand() % 255U));
+	}
+
+	if (impl->memcmp(s1, s2, len) != byte_diff(s1, s2, len)) {
+		fail(impl, "memcmp", len, off1, off2);
+	}
+	if (impl->memcmp(s2, s1, len) != byte_diff(s2, s1, len)) {
+		fail(impl, "memcmp", len, off2, off1);
+	}
+}
+
+static void check_memcmp(const impl_t *impl, size_t len, size_t off1,
+			 size_t off2)
+{
+	/* Equal, then a difference at each position or a few of them */
+	check_memcmp_at(impl, len, off1, off2, len);
+	if (len <= 32U) {
+		for (size_t pos = 0U; pos < len; pos++) {
+			check_memcmp_at(impl, len, off1, off2, pos);
+		}
+	} else {
+		check_memcmp_at(impl, len, off1, off2, 0U);
+		check_memcmp_at(impl, len, off1, off2, len - 1U);
+		check_memcmp_at(impl, len, off1, off2, (size_t)rand() % len);
+	}
+}
+
+static void test_small(const impl_t *impl)
+{
+	for (size_t len = 0U; len <= MAX_SMALL; len++) {
+		for (size_t i = 0U; i < MAX_ALIGN; i++) {
+			for (size_t j = 0U; j < MAX_ALIGN; j++) {
+				check_memcpy(impl, len, i, j);
+				check_memcmp(impl, len, i, j);
+			}
+			for (long shift = -(long)MAX_ALIGN;
+			     shift <= (long)MAX_ALIGN; shift++) {
+				check_memmove(impl, len, i, shift);
+			}
+		}
+	}
+
+	printf("%s: sizes up to %u, all alignments: OK\n", impl->name,
+	       MAX_SMALL);
+}
+
+static void test_random(const impl_t *impl, unsigned int iterations)
+{
+	size_t len, i, j;
+	long shift;
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		len = (size_t)rand() % (MAX_RANDOM + 1U);
+		i = (size_t)rand() % MAX_ALIGN;
+		j = (size_t)rand() % MAX_ALIGN;
+		shift = (long)((size_t)rand() % (2U * MAX_ALIGN + 1U)) -
+			(long)MAX_ALIGN;
+
+		if (verbose != 0) {
+			printf("%s: size %zu, offsets %zu %zu, shift %ld\n",
+			       impl->name, len, i, j, shift);
+		}
+
+		check_memcpy(impl, len, i, j);
+		check_memmove(impl, len, i, shift);
+		check_memcmp(impl, len, i, j);
+	}
+
+	printf("%s: %u random sizes up to %u: OK\n", impl->name, iterations,
+	       MAX_RANDOM);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Throughput in MB/s of 'iterations' calls of an operation */
+#define BENCH(_iterations, _len, _call)					\
+	({								\
+		uint64_t _t0 = now_ns();				\
+		for (unsigned int _n = 0U; _n < (_iterations); _n++) {	\
+			_call;						\
+			__asm__ volatile("" : : : "memory");		\
+		}							\
+		((uint64_t)(_iterations) * (_len) * 1000U) /		\
+			(now_ns() - _t0 + 1U);				\
+	})
+
+static void bench(const impl_t *impl, size_t len, size_t src_off,
+		  unsigned int iterations)
+{
+	uint8_t *src = &src_buf[GUARD + src_off];
+	uint8_t *dst = &dst_buf[GUARD];
+	uint64_t cpy, move, cmp;
+
+	/* Process the same number of bytes whatever the size */
+	iterations = (unsigned int)(((unsigned long)iterations * MAX_RANDOM) /
+				    len);
+
+	random_fill(src, len);
+
+	/* memcmp runs through the whole buffers, which memcpy left equal */
+	cpy = BENCH(iterations, len, impl->memcpy(dst, src, len));
+	cmp = BENCH(iterations, len, (void)impl->memcmp(src, dst, len));
+	move = BENCH(iterations, len, impl->memmove(dst + 8U, dst, len));
+
+	printf("%-8s %6zu bytes, source offset %2zu: memcpy %6" PRIu64
+	       " MB/s, memmove %6" PRIu64 " MB/s, memcmp %6" PRIu64 " MB/s\n",
+	       impl->name, len, src_off, cpy, move, cmp);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-v] [-b] [-n iterations] [-s seed]\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	static const size_t bench_sizes[] = { 8U, 64U, 512U, 4096U, 65536U };
+	unsigned int iterations = 1000U;
+	unsigned int seed = 1U;
+	bool benchmark = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:s:")) != -1) {
+		switch (opt) {
+		case 'v':
+			verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U)) {
+		usage(argv[0]);
+	}
+
+	srand(seed);
+
+	src_buf = xmalloc(BUF_SIZE);
+	dst_buf = xmalloc(BUF_SIZE);
+	ref_buf = xmalloc(BUF_SIZE);
+	random_fill(src_buf, BUF_SIZE);
+
+	for (size_t i = 0U; i < ARRAY_SIZE(impls); i++) {
+		if (benchmark) {
+			for (size_t s = 0U; s < ARRAY_SIZE(bench_sizes); s++) {
+				bench(&impls[i], bench_sizes[s], 0U,
+				      iterations);
+				bench(&impls[i], bench_sizes[s], 3U,
+				      iterations);
+			}
+		} else {
+			test_small(&impls[i]);
+			test_random(&impls[i], iterations);
+		}
+	}
+
+	if (benchmark) {
+		for (size_t s = 0U; s < ARRAY_SIZE(bench_sizes); s++) {
+			bench(&host_impl, bench_sizes[s], 0U, iterations);
+			bench(&host_impl, bench_sizes[s], 3U, iterations);
+		}
+	}
+
+	free(src_buf);
+	free(dst_buf);
+	free(ref_buf);
+
+	return 0;
+}
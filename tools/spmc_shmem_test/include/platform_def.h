@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef PLATFORM_DEF_H
+#define PLATFORM_DEF_H
+
+/* Platform definitions needed by the SPMC headers */
+
+#define CACHE_WRITEBACK_GRANULE		64
+#define PLATFORM_CORE_COUNT		8
+#define PLAT_MAX_PWR_LVL		2
+#define PLAT_MAX_RET_STATE		1
+#define PLAT_MAX_OFF_STATE		2
+#define NR_OF_FW_BANKS			2
+#define NR_OF_IMAGES_IN_FW_BANK		1
+#define SPMC_AT_EL3_PARTITION_MAX_UUIDS	4
+
+#endif /* PLATFORM_DEF_H */
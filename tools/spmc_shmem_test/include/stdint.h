@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SPMC_SHMEM_TEST_STDINT_H
+#define SPMC_SHMEM_TEST_STDINT_H
+
+/* Host stdint.h with the register type of the firmware C library */
+
+#include_next <stdint.h>
+
+typedef unsigned long u_register_t;
+
+#endif /* SPMC_SHMEM_TEST_STDINT_H */
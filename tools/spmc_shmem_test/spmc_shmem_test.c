@@ -0,0 +1,579 @@
+/*
+ * Copyright (c) 2026, Arm Limited and Contributors. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Host test of the shared memory object allocator and handle index of the EL3
+ * SPMC. spmc_shared_mem.c is built into the test so that its allocator and
+ * handle index helpers can be called directly. A long sequence of random
+ * allocations, frees and lookups is checked against a model of the datastore,
+ * the handle index is driven into clusters of colliding entries that wrap
+ * around its end, and the cost of the operations is measured with thousands
+ * of live objects.
+ */
+
+#include <time.h>
+#include <unistd.h>
+
+#include "spmc_shared_mem.c"
+
+int spmc_shmem_test_verbose;
+
+/* Functions of the rest of the SPMC, which the tested helpers do not use */
+void spin_lock(spinlock_t *lock)
+{
+}
+
+void spin_unlock(spinlock_t *lock)
+{
+}
+
+uint32_t get_partition_ffa_version(bool secure_origin)
+{
+	abort();
+}
+
+uint64_t spmc_ffa_error_return(void *handle, int error_code)
+{
+	abort();
+}
+
+struct secure_partition_desc *spmc_get_current_sp_ctx(void)
+{
+	abort();
+}
+
+struct mailbox *spmc_get_mbox_desc(bool secure_origin)
+{
+	abort();
+}
+
+struct secure_partition_desc *spmc_get_sp_ctx(uint16_t id)
+{
+	abort();
+}
+
+int plat_spmc_shmem_begin(struct ffa_mtd *desc)
+{
+	abort();
+}
+
+int plat_spmc_shmem_reclaim(struct ffa_mtd *desc)
+{
+	abort();
+}
+
+/* Largest descriptor size used by the random allocations */
+#define MAX_DESC_SIZE		(4U * 1024U)
+
+/* Model of an allocated object */
+typedef struct live_obj {
+	struct spmc_shmem_obj *obj;
+	uint64_t handle;
+	bool has_handle;
+	size_t first;
+	size_t count;
+} live_obj_t;
+
+typedef struct model {
+	struct spmc_shmem_obj_state state;
+	live_obj_t *live;
+	size_t live_count;
+	/* Index in @live of the object owning each block, or SIZE_MAX */
+	size_t *owner;
+	/* Handles that have been freed, which must not be found any more */
+	uint64_t *freed;
+	size_t freed_count;
+	size_t freed_max;
+} model_t;
+
+/*
+ * Stop at the first failure, as a broken allocator or index can make the next
+ * operations loop forever.
+ */
+static void __dead2 fail(const char *what)
+{
+	fprintf(stderr, "FAILED: %s\n", what);
+	exit(1);
+}
+
+static void *xcalloc(size_t count, size_t size)
+{
+	void *ptr = calloc(count, size);
+
+	if (ptr == NULL) {
+		perror("calloc");
+		exit(2);
+	}
+
+	return ptr;
+}
+
+static size_t random_desc_size(void)
+{
+	size_t size;
+
+	/* Mostly small descriptors, with a few large ones */
+	if (((unsigned int)rand() % 16U) == 0U) {
+		size = (size_t)rand() % MAX_DESC_SIZE;
+	} else {
+		size = sizeof(struct ffa_mtd) + ((size_t)rand() % 256U);
+	}
+
+	return round_up(size, 16U);
+}
+
+static void model_init(model_t *m, size_t data_size)
+{
+	*m = (model_t){ 0 };
+	m->state.data = aligned_alloc(SPMC_SHMEM_BLOCK_SIZE,
+				      round_up(data_size,
+					       SPMC_SHMEM_BLOCK_SIZE));
+	if (m->state.data == NULL) {
+		perror("aligned_alloc");
+		exit(2);
+	}
+
+	memset(m->state.data, 0, data_size);
+	m->state.data_size = data_size;
+	m->state.next_handle = 0xffffffc0U;
+	spmc_shmem_obj_state_init(&m->state);
+
+	m->live = xcalloc(m->state.block_count + 1U, sizeof(*m->live));
+	m->owner = xcalloc(m->state.block_count + 1U, sizeof(*m->owner));
+	for (size_t i = 0U; i < m->state.block_count; i++) {
+		m->owner[i] = SIZE_MAX;
+	}
+	m->freed_max = 1024U;
+	m->freed = xcalloc(m->freed_max, sizeof(*m->freed));
+}
+
+static void model_destroy(model_t *m)
+{
+	free(m->state.data);
+	free(m->live);
+	free(m->owner);
+	free(m->freed);
+}
+
+/* First fit, as the allocator is expected to do */
+static size_t model_find_free(const model_t *m, size_t count)
+{
+	size_t run = 0U;
+
+	for (size_t block = 0U; block < m->state.block_count; block++) {
+		run = (m->owner[block] == SIZE_MAX) ? (run + 1U) : 0U;
+		if (run == count) {
+			return block + 1U - count;
+		}
+	}
+
+	return m->state.block_count;
+}
+
+/* Fill the blocks of an object past its header with a known pattern */
+static void pattern_fill(const live_obj_t *l)
+{
+	uint8_t *ptr = (uint8_t *)l->obj;
+	size_t end = l->count * SPMC_SHMEM_BLOCK_SIZE;
+
+	for (size_t i = sizeof(struct spmc_shmem_obj); i < end; i++) {
+		ptr[i] = (uint8_t)((l->first * 31U) + i);
+	}
+}
+
+static bool pattern_check(const live_obj_t *l)
+{
+	const uint8_t *ptr = (const uint8_t *)l->obj;
+	size_t end = l->count * SPMC_SHMEM_BLOCK_SIZE;
+
+	for (size_t i = sizeof(struct spmc_shmem_obj); i < end; i++) {
+		if (ptr[i] != (uint8_t)((l->first * 31U) + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool model_alloc(model_t *m, size_t desc_size, bool with_handle)
+{
+	size_t count = spmc_shmem_obj_blocks(spmc_shmem_obj_size(desc_size));
+	size_t expected = m->state.block_count;
+	struct spmc_shmem_obj *obj;
+	live_obj_t *l;
+
+	if (count <= m->state.block_count) {
+		expected = model_find_free(m, count);
+	}
+
+	obj = spmc_shmem_obj_alloc(&m->state, desc_size);
+	if (obj == NULL) {
+		if (expected != m->state.block_count) {
+			fail("allocation failed with enough free blocks");
+		}
+		return false;
+	}
+
+	l = &m->live[m->live_count];
+	*l = (live_obj_t){ .obj = obj, .count = count,
+			   .first = spmc_shmem_obj_to_block(&m->state, obj) };
+
+	if (l->first != expected) {
+		fail("allocation did not return the first free run");
+	}
+
+	for (size_t block = l->first; block < (l->first + count); block++) {
+		if ((block >= m->state.block_count) ||
+		    (m->owner[block] != SIZE_MAX)) {
+			fail("allocation overlaps another object");
+		}
+		m->owner[block] = m->live_count;
+	}
+
+	if ((obj->desc_size != desc_size) || (obj->desc_filled != 0U) ||
+	    (obj->in_use != 0U) || (obj->desc.handle != 0U)) {
+		fail("allocated object not initialised");
+	}
+
+	pattern_fill(l);
+
+	if (with_handle) {
+		l->handle = spmc_shmem_obj_new_handle(&m->state);
+		l->has_handle = true;
+		spmc_shmem_obj_set_handle(&m->state, obj, l->handle);
+	}
+
+	m->live_count++;
+
+	return true;
+}
+
+static void model_free(model_t *m, size_t i)
+{
+	live_obj_t *l = &m->live[i];
+
+	if ((l->obj->desc.handle != l->handle) || !pattern_check(l)) {
+		fail("object modified by another allocation");
+	}
+
+	spmc_shmem_obj_free(&m->state, l->obj);
+
+	for (size_t block = l->first; block < (l->first + l->count); block++) {
+		m->owner[block] = SIZE_MAX;
+	}
+
+	if (l->has_handle) {
+		m->freed[m->freed_count % m->freed_max] = l->handle;
+		m->freed_count++;
+	}
+
+	/* Move the last object into the slot of the freed one */
+	m->live_count--;
+	if (i != m->live_count) {
+		*l = m->live[m->live_count];
+		for (size_t block = l->first; block < (l->first + l->count);
+		     block++) {
+			m->owner[block] = i;
+		}
+	}
+}
+
+/* Check the allocator and the index against the model */
+static void model_check(model_t *m)
+{
+	size_t allocated = 0U, with_handle = 0U, found = 0U, offset = 0U;
+	struct spmc_shmem_obj *obj;
+
+	for (size_t i = 0U; i < m->live_count; i++) {
+		const live_obj_t *l = &m->live[i];
+
+		allocated += l->count * SPMC_SHMEM_BLOCK_SIZE;
+		if (l->has_handle) {
+			with_handle++;
+			if (spmc_shmem_obj_lookup(&m->state, l->handle) !=
+			    l->obj) {
+				fail("live object not found by its handle");
+			}
+		}
+	}
+
+	for (size_t i = 0U; (i < m->freed_count) && (i < m->freed_max); i++) {
+		if (spmc_shmem_obj_lookup(&m->state, m->freed[i]) != NULL) {
+			fail("freed object found by its handle");
+		}
+	}
+
+	for (size_t block = 0U; block < m->state.block_count; block++) {
+		if (spmc_shmem_block_is_used(&m->state, block) !=
+		    (m->owner[block] != SIZE_MAX)) {
+			fail("block bitmap differs from the model");
+			break;
+		}
+	}
+
+	if (m->state.allocated != allocated) {
+		fail("allocated size differs from the model");
+	}
+
+	/* Every object with a handle is listed exactly once */
+	while ((obj = spmc_shmem_obj_get_next(&m->state, &offset)) != NULL) {
+		size_t block = spmc_shmem_obj_to_block(&m->state, obj);
+
+		if ((block >= m->state.block_count) ||
+		    (m->owner[block] == SIZE_MAX) ||
+		    (m->live[m->owner[block]].obj != obj) ||
+		    !m->live[m->owner[block]].has_handle) {
+			fail("listed object is not live or has no handle");
+		}
+		found++;
+	}
+
+	if (found != with_handle) {
+		fail("objects listed differ from the model");
+	}
+}
+
+/* Random allocations and frees, checked against the model */
+static void test_churn(size_t data_size, unsigned int iterations)
+{
+	model_t m;
+
+	model_init(&m, data_size);
+
+	for (unsigned int i = 0U; i < iterations; i++) {
+		unsigned int op = (unsigned int)rand() % 100U;
+
+		if ((op < 55U) || (m.live_count == 0U)) {
+			/* Temporary objects of other cores have no handle */
+			(void)model_alloc(&m, random_desc_size(), op != 0U);
+		} else {
+			model_free(&m, (size_t)rand() % m.live_count);
+		}
+
+		if ((i % 997U) == 0U) {
+			model_check(&m);
+		}
+	}
+
+	model_check(&m);
+
+	/* Free everything, the whole datastore must be usable again */
+	while (m.live_count != 0U) {
+		model_free(&m, (size_t)rand() % m.live_count);
+	}
+	model_check(&m);
+
+	if (spmc_shmem_obj_alloc(&m.state, round_down(
+		(m.state.block_count * SPMC_SHMEM_BLOCK_SIZE) -
+		offsetof(struct spmc_shmem_obj, desc), 16U)) == NULL) {
+		fail("datastore fragmented after freeing all objects");
+	}
+
+	printf("churn %zu bytes, %zu blocks: OK\n", data_size,
+	       m.state.block_count);
+
+	model_destroy(&m);
+}
+
+static bool handle_is_live(const model_t *m, uint64_t handle)
+{
+	for (size_t i = 0U; i < m->live_count; i++) {
+		if (m->live[i].has_handle && (m->live[i].handle == handle)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Give the objects handles that hash to a few slots around the end of the
+ * index, so that probe sequences wrap around, then remove them in random
+ * order. This exercises the backward shift of the entries on removal.
+ */
+static void test_index_collisions(unsigned int rounds)
+{
+	size_t desc_size = round_up(sizeof(struct ffa_mtd), 16U);
+	size_t nhandles = 0U;
+	uint64_t *handles;
+	model_t m;
+
+	model_init(&m, 16U * 1024U);
+	handles = xcalloc(m.state.block_count, sizeof(*handles));
+
+	for (uint64_t h = 1U; nhandles < m.state.block_count; h++) {
+		size_t slot = spmc_shmem_index_hash(&m.state, h);
+
+		if ((slot >= (m.state.index_mask - 1U)) || (slot <= 1U)) {
+			handles[nhandles++] = h;
+		}
+	}
+
+	for (unsigned int r = 0U; r < rounds; r++) {
+		size_t next = (size_t)rand() % nhandles;
+
+		/* Fill the datastore with objects of the colliding handles */
+		while (m.live_count < nhandles) {
+			live_obj_t *l;
+
+			if (!model_alloc(&m, desc_size, false)) {
+				break;
+			}
+
+			/* Skip the handles of the objects left from before */
+			while (handle_is_live(&m, handles[next])) {
+				next = (next + 1U) % nhandles;
+			}
+
+			l = &m.live[m.live_count - 1U];
+			l->handle = handles[next];
+			l->has_handle = true;
+			next = (next + 1U) % nhandles;
+			spmc_shmem_obj_set_handle(&m.state, l->obj, l->handle);
+		}
+		model_check(&m);
+
+		/* Then remove most of them, checking all lookups each time */
+		while (m.live_count > ((size_t)rand() % 4U)) {
+			model_free(&m, (size_t)rand() % m.live_count);
+			/* Handles are reused here, forget the freed ones */
+			m.freed_count = 0U;
+			model_check(&m);
+		}
+	}
+
+	printf("index collisions, %zu entries: OK\n",
+	       (size_t)m.state.index_mask + 1U);
+
+	free(handles);
+	model_destroy(&m);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * Measure the allocation, the handle lookup and the free of an object, as done
+ * by a share and reclaim, with @live objects in the datastore.
+ */
+static void bench(size_t live, unsigned int iterations)
+{
+	uint64_t t_alloc = 0U, t_lookup = 0U, t_free = 0U, t0;
+	struct spmc_shmem_obj_state state = { 0 };
+	struct spmc_shmem_obj **objs;
+	uint64_t *handles;
+	size_t data_size = (live * 2048U) + (64U * 1024U);
+
+	state.data = xcalloc(1U, data_size);
+	state.data_size = data_size;
+	state.next_handle = 0xffffffc0U;
+	spmc_shmem_obj_state_init(&state);
+
+	objs = xcalloc(live, sizeof(*objs));
+	handles = xcalloc(live, sizeof(*handles));
+
+	for (size_t i = 0U; i < live; i++) {
+		objs[i] = spmc_shmem_obj_alloc(&state, random_desc_size());
+		if (objs[i] == NULL) {
+			fail("benchmark datastore too small");
+		}
+		handles[i] = spmc_shmem_obj_new_handle(&state);
+		spmc_shmem_obj_set_handle(&state, objs[i], handles[i]);
+	}
+
+	for (unsigned int n = 0U; n < iterations; n++) {
+		size_t i = (size_t)rand() % live;
+
+		t0 = now_ns();
+		if (spmc_shmem_obj_lookup(&state, handles[i]) != objs[i]) {
+			fail("benchmark lookup");
+		}
+		t_lookup += now_ns() - t0;
+
+		t0 = now_ns();
+		spmc_shmem_obj_free(&state, objs[i]);
+		t_free += now_ns() - t0;
+
+		t0 = now_ns();
+		objs[i] = spmc_shmem_obj_alloc(&state, random_desc_size());
+		if (objs[i] == NULL) {
+			fail("benchmark allocation");
+		}
+		handles[i] = spmc_shmem_obj_new_handle(&state);
+		spmc_shmem_obj_set_handle(&state, objs[i], handles[i]);
+		t_alloc += now_ns() - t0;
+	}
+
+	printf("%6zu live objects: alloc %5" PRIu64 " ns, lookup %5" PRIu64
+	       " ns, free %5" PRIu64 " ns\n", live, t_alloc / iterations,
+	       t_lookup / iterations, t_free / iterations);
+
+	free(objs);
+	free(handles);
+	free(state.data);
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr, "Usage: %s [-v] [-b] [-n iterations] [-s seed]\n",
+		prog);
+	exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+	static const size_t live_counts[] = { 16U, 256U, 1024U, 4096U, 16384U };
+	static const size_t data_sizes[] = { 4U * 1024U, 20U * 1024U,
+					     512U * 1024U, 4U * 1024U * 1024U };
+	unsigned int iterations = 100000U;
+	unsigned int seed = 1U;
+	bool benchmark = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "vbn:s:")) != -1) {
+		switch (opt) {
+		case 'v':
+			spmc_shmem_test_verbose = 1;
+			break;
+		case 'b':
+			benchmark = true;
+			break;
+		case 'n':
+			iterations = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = (unsigned int)strtoul(optarg, NULL, 0);
+			break;
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if ((optind != argc) || (iterations == 0U)) {
+		usage(argv[0]);
+	}
+
+	srand(seed);
+
+	if (benchmark) {
+		for (size_t i = 0U; i < ARRAY_SIZE(live_counts); i++) {
+			bench(live_counts[i], iterations);
+		}
+	} else {
+		for (size_t i = 0U; i < ARRAY_SIZE(data_sizes); i++) {
+			test_churn(data_sizes[i], iterations);
+		}
+		test_index_collisions(iterations / 100U);
+	}
+
+	return 0;
+}